@@ -0,0 +1,108 @@
+/*
+ * Si57x.cpp
+ *
+ * Si57x programmable oscillator divider solver
+ */
+
+#include <string.h>
+
+#include "Si57x.h"
+
+/* High speed divider values and their register encoding, highest first */
+static const uint32_t hsDivOpt[SI57X_NUM_HS_DIV] = {11, 9, 7, 6, 5, 4};
+static const uint32_t hsDivVal[SI57X_NUM_HS_DIV] = {7, 5, 3, 2, 1, 0};
+
+Si57xSolver::Si57xSolver()
+    : cacheNext(0)
+{
+    memset(cache, 0, sizeof(cache));
+}
+
+bool Si57xSolver::solve(uint32_t freq, si57xRegs_t *regs)
+{
+    for (unsigned i = 0; i < SI57X_CACHE_SIZE; ++i) {
+        if (cache[i].valid && cache[i].freq == freq) {
+            *regs = cache[i].regs;
+            return cache[i].found;
+        }
+    }
+
+    cacheEntry_t &entry = cache[cacheNext];
+    cacheNext = (cacheNext + 1) % SI57X_CACHE_SIZE;
+
+    entry.found = solveUncached(freq, &entry.regs);
+    entry.freq = freq;
+    entry.valid = true;
+    *regs = entry.regs;
+
+    return entry.found;
+}
+
+/* For each HS_DIV, the N1 values that put the DCO in range follow from the
+ * DCO limits in closed form. N1 can only be 1 or even, so the candidates
+ * are bounded by SI57X_NUM_HS_DIV * (SI57X_N1_MAX/2 + 1) no matter the
+ * requested frequency */
+bool Si57xSolver::solveUncached(uint32_t freq, si57xRegs_t *regs)
+{
+    bool found = false;
+    uint64_t bestFdco = 0;
+    double bestErr = 0.0;
+
+    if (freq < SI57X_FOUT_MIN || freq > SI57X_FOUT_MAX) {
+        return false;
+    }
+
+    for (unsigned i = 0; i < SI57X_NUM_HS_DIV; ++i) {
+        uint64_t step = uint64_t(freq)*hsDivOpt[i];
+        uint64_t n1Min = (SI57X_FDCO_MIN + step - 1)/step;
+        uint64_t n1Max = SI57X_FDCO_MAX/step;
+        uint64_t n1 = 0;
+
+        if (n1Max > SI57X_N1_MAX) {
+            n1Max = SI57X_N1_MAX;
+        }
+
+        /* First valid N1: 1 or the first even value not below n1Min */
+        n1 = (n1Min <= 1)? 1 : n1Min + (n1Min & 1);
+
+        for (; n1 <= n1Max; n1 = (n1 == 1)? 2 : n1 + 2) {
+            uint64_t fdco = step*n1;
+            /* Nearest RFREQ. fdco < 2^33, so the numerator fits in 64 bits */
+            uint64_t rfreq = ((fdco << SI57X_RFREQ_FRAC_BITS) + SI57X_FXTAL/2)/SI57X_FXTAL;
+            double achieved = double(rfreq)*double(SI57X_FXTAL)/
+                double(1ULL << SI57X_RFREQ_FRAC_BITS)/double(hsDivOpt[i]*n1);
+            double err = achieved - double(freq);
+            double absErr = (err < 0.0)? -err : err;
+            double bestAbsErr = (bestErr < 0.0)? -bestErr : bestErr;
+
+            if (!found || absErr < bestAbsErr ||
+                    (absErr == bestAbsErr && fdco < bestFdco)) {
+                found = true;
+                bestFdco = fdco;
+                bestErr = err;
+                regs->n1 = uint32_t(n1 - 1);
+                regs->hsDiv = hsDivVal[i];
+                regs->rfreqLo = uint32_t(rfreq & ((1ULL << SI57X_RFREQ_LO_BITS) - 1));
+                regs->rfreqHi = uint32_t(rfreq >> SI57X_RFREQ_LO_BITS);
+                regs->freqErr = err;
+            }
+        }
+    }
+
+    return found;
+}
+
+double Si57xSolver::outputFreq(uint32_t n1, uint32_t hsDiv, uint32_t rfreqLo,
+        uint32_t rfreqHi)
+{
+    uint64_t rfreq = (uint64_t(rfreqHi) << SI57X_RFREQ_LO_BITS) + rfreqLo;
+    double fdco = double(rfreq)*double(SI57X_FXTAL)/double(1ULL << SI57X_RFREQ_FRAC_BITS);
+
+    for (unsigned i = 0; i < SI57X_NUM_HS_DIV; ++i) {
+        if (hsDiv == hsDivVal[i]) {
+            return fdco/double((n1 + 1)*hsDivOpt[i]);
+        }
+    }
+
+    return 0.0;
+}
@@ -0,0 +1,65 @@
+/*
+ * Si57x.h
+ *
+ * Si57x programmable oscillator divider solver
+ */
+
+#ifndef SI57X_H
+#define SI57X_H
+
+#include <stdint.h>
+
+/* From Si57x datasheet */
+#define SI57X_FXTAL                 114285000ULL
+#define SI57X_FDCO_MIN              4850000000ULL
+#define SI57X_FDCO_MAX              5670000000ULL
+#define SI57X_RFREQ_FRAC_BITS       28
+#define SI57X_RFREQ_LO_BITS         20
+#define SI57X_N1_MAX                128
+#define SI57X_NUM_HS_DIV            6
+
+/* Output frequency range reachable with a valid divider combination */
+#define SI57X_FOUT_MIN              ((SI57X_FDCO_MIN + 11*SI57X_N1_MAX - 1)/(11*SI57X_N1_MAX))
+#define SI57X_FOUT_MAX              (SI57X_FDCO_MAX/4)
+
+/* Number of recently requested frequencies remembered by the solver */
+#define SI57X_CACHE_SIZE            16
+
+/* Si57x register settings for one output frequency */
+typedef struct {
+    uint32_t n1;            /* N1 register value, N1 - 1 */
+    uint32_t hsDiv;         /* HS_DIV register value, HS_DIV - 4 */
+    uint32_t rfreqLo;       /* RFREQ[19:0] */
+    uint32_t rfreqHi;       /* RFREQ[37:20] */
+    double freqErr;         /* Achieved minus requested frequency, in Hz */
+} si57xRegs_t;
+
+class Si57xSolver {
+    public:
+        Si57xSolver();
+
+        /* Find the registers for the requested output frequency, in Hz.
+         * Among all valid (HS_DIV, N1) pairs the one with the smallest
+         * frequency error is chosen. Ties go to the lowest DCO frequency,
+         * which draws the least power. Returns false if the frequency
+         * can not be generated */
+        bool solve(uint32_t freq, si57xRegs_t *regs);
+        static bool solveUncached(uint32_t freq, si57xRegs_t *regs);
+
+        /* Output frequency, in Hz, generated by the given registers */
+        static double outputFreq(uint32_t n1, uint32_t hsDiv, uint32_t rfreqLo,
+                uint32_t rfreqHi);
+
+    private:
+        typedef struct {
+            bool valid;
+            bool found;
+            uint32_t freq;
+            si57xRegs_t regs;
+        } cacheEntry_t;
+
+        cacheEntry_t cache[SI57X_CACHE_SIZE];
+        unsigned cacheNext;
+};
+
+#endif
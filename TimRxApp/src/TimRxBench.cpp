@@ -0,0 +1,554 @@
+/* Throughput and latency benchmark of the drvTimRx driver.
+ *
+ * Instantiates drvTimRx ports on top of TimRxHalcsStandIn, so no board
+ * nor broker is needed, and drives readUInt32Digital/writeUInt32Digital
+ * through asyn from a number of client threads, as records on several
+ * IOC scan threads would. Results are reported per parameter class
+ * (status, per-channel config, counters, Si57x) and written as CSV.
+ *
+ * The stand-in device model is tuned with the HALCS_STANDIN_* environment
+ * variables, see TimRxHalcsStandIn.c. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+
+#include <epicsTypes.h>
+#include <epicsTime.h>
+#include <epicsThread.h>
+#include <epicsEvent.h>
+#include <epicsAtomic.h>
+#include <epicsExit.h>
+#include <epicsStdio.h>
+#include <asynDriver.h>
+#include <asynUInt32DigitalSyncIO.h>
+#include <asynFloat64SyncIO.h>
+
+#define DFLT_ENDPOINT               "ipc:///tmp/malamute"
+#define DFLT_DURATION               2.0
+/* HALCS client timeout, in milliseconds, as in TimRx.config */
+#define DFLT_TIMEOUT                2000
+#define DFLT_CONCURRENCY            "1,2,4,8"
+#define DFLT_WORKERS                "1"
+#define DFLT_OUTPUT                 "TimRxBench.csv"
+#define MAX_LIST                    16
+#define BENCH_PORT_PREFIX           "TIM_RX_BENCH"
+#define BENCH_IO_TIMEOUT            2.0
+/* Interval between the readbacks of a held write, in seconds */
+#define BENCH_READBACK_POLL         100e-6
+/* Register shadow TTL during burst runs, in seconds. The shadow takes a
+ * written value once it reached hardware, so readbacks of held writes
+ * are served from memory and do not load the port */
+#define BENCH_BURST_SHADOW_TTL      60.0
+/* Write holdoff during burst runs, in seconds. Writes are only held, and
+ * flushed by the write workers, with a holdoff set */
+#define BENCH_BURST_HOLDOFF         200e-6
+/* Ports are put on receivers of different boards, see main */
+#define BENCH_MAX_PORTS             12
+
+/* Defined in drvTimRx.cpp */
+extern "C" int drvTimRxConfigure(const char *portName, const char *endpoint,
+        int timRxNumber, int verbose, int timeout, int numWorkers);
+
+typedef struct {
+    const char *benchClass;
+    const char *drvInfo;
+    int numAddr;
+    int write;
+    /* Writes alternate between value and value+step, so none of them
+     * is elided as a write of the value already in the register */
+    epicsUInt32 value;
+    epicsUInt32 step;
+    /* The write may complete while held by the coalescing stage. It is
+     * timed until a readback returns the value, so it measures the write
+     * reaching hardware and not it being queued */
+    int readback;
+} benchParam_t;
+
+static const benchParam_t benchParams[] = {
+    {"status",   "TIM_RX_LINK_STATUS",      1, 0, 0, 0, 0},
+    {"status",   "TIM_RX_RXEN_STATUS",      1, 0, 0, 0, 0},
+    {"status",   "TIM_RX_REF_CLK_LOCKED",   1, 0, 0, 0, 0},
+    {"status",   "TIM_RX_ALIVE",            1, 0, 0, 0, 0},
+    {"config",   "TIM_RX_AMC_DLY",          8, 1, 100, 1, 1},
+    {"config",   "TIM_RX_AMC_WDT",          8, 1, 10, 1, 1},
+    {"config",   "TIM_RX_AMC_EVT",          8, 1, 1, 1, 0},
+    {"config",   "TIM_RX_AMC_DLY",          8, 0, 0, 0, 0},
+    {"config",   "TIM_RX_AMC_EN",           8, 0, 0, 0, 0},
+    {"counters", "TIM_RX_AMC_CNT",          8, 0, 0, 0, 0},
+    {"counters", "TIM_RX_FMC1_CNT",         5, 0, 0, 0, 0},
+    {"counters", "TIM_RX_FMC2_CNT",         5, 0, 0, 0, 0},
+    {"si57x",    "TIM_RX_AFC_SI57XFREQ",    1, 1, 125000000, 100000, 0},
+    {"si57x",    "TIM_RX_AFC_SI57XFREQ",    1, 0, 0, 0, 0},
+    {"burst",    "TIM_RX_AMC_DLY",          8, 1, 200, 1, 1},
+    {"burst",    "TIM_RX_AMC_WDT",          8, 1, 20, 1, 1},
+};
+
+#define NUM_BENCH_PARAMS (sizeof(benchParams)/sizeof(benchParams[0]))
+
+typedef struct {
+    const char *name;
+    /* Each round writes every register of the class, then reads them
+     * back, as a restore or a script setting every channel does. This
+     * times writes held by the write workers until they reach hardware */
+    int burst;
+} benchClass_t;
+
+static const benchClass_t benchClasses[] = {
+    {"status",   0},
+    {"config",   0},
+    {"counters", 0},
+    {"si57x",    0},
+    {"burst",    1},
+};
+
+#define NUM_BENCH_CLASSES (sizeof(benchClasses)/sizeof(benchClasses[0]))
+
+/* Accesses of one client thread. Each thread has its own asynUser per
+ * (parameter, address), as each record has its own. Each register is
+ * written by a single thread, so a readback finds its own value */
+typedef struct {
+    const benchParam_t *param;
+    int addr;
+    asynUser *pasynUser;
+} benchAccess_t;
+
+typedef struct {
+    int id;
+    std::vector<benchAccess_t> accesses;
+    /* Latencies in microseconds, for reads and writes */
+    std::vector<double> lat[2];
+    unsigned long errors[2];
+    epicsEventId doneEvent;
+} benchThread_t;
+
+static epicsEventId startEvent;
+static int stopFlag;
+
+static void print_help (const char *program_name)
+{
+    printf( "Usage: %s [options]\n"
+            "\t-h This help message\n"
+            "\t-v Verbose output\n"
+            "\t-c <concurrency list> Client threads, as in \"1,2,4,8\" (default %s)\n"
+            "\t-w <workers list> Write workers of the driver, up to %d entries, as in \"1,2,4,8\" (default %s)\n"
+            "\t-d <seconds> Duration of each run (default %.1f)\n"
+            "\t-k <class> Only run this class [status|config|counters|si57x|burst]\n"
+            "\t-b <endpoint> Broker endpoint passed to the driver (default %s)\n"
+            "\t-o <file> CSV results file (default %s)\n"
+            , program_name, DFLT_CONCURRENCY, BENCH_MAX_PORTS, DFLT_WORKERS, DFLT_DURATION,
+            DFLT_ENDPOINT, DFLT_OUTPUT);
+}
+
+/* Parse "1,2,4,8" into list. Returns the number of entries or -1 */
+static int parseList (const char *str, int *list, int maxEntries)
+{
+    int n = 0;
+    const char *p = str;
+    char *end;
+
+    while (*p) {
+        long v = strtol(p, &end, 10);
+        if (end == p || v <= 0 || n >= maxEntries) {
+            return -1;
+        }
+        list[n++] = (int)v;
+        p = end;
+        if (*p == ',') {
+            p++;
+        }
+        else if (*p) {
+            return -1;
+        }
+    }
+
+    return n;
+}
+
+static double percentile (const std::vector<double> &sorted, double p)
+{
+    size_t idx;
+
+    if (sorted.empty()) {
+        return 0.0;
+    }
+
+    idx = (size_t)(p*(double)(sorted.size()-1) + 0.5);
+    return sorted[idx];
+}
+
+/* Read access back until it holds value. Returns asynTimeout if it does
+ * not within BENCH_IO_TIMEOUT */
+static asynStatus benchReadback (benchAccess_t *access, epicsUInt32 value,
+        const epicsTimeStamp *start)
+{
+    epicsUInt32 readValue = 0;
+    epicsTimeStamp now;
+    asynStatus status;
+
+    while (1) {
+        status = pasynUInt32DigitalSyncIO->read(access->pasynUser,
+                &readValue, 0xFFFFFFFF, BENCH_IO_TIMEOUT);
+        if (status != asynSuccess || readValue == value) {
+            return status;
+        }
+        epicsTimeGetCurrent(&now);
+        if (epicsTimeDiffInSeconds(&now, start) > BENCH_IO_TIMEOUT) {
+            return asynTimeout;
+        }
+        epicsThreadSleep(BENCH_READBACK_POLL);
+    }
+}
+
+static void benchTask (void *pvt)
+{
+    benchThread_t *thread = (benchThread_t *)pvt;
+    size_t numAccesses = thread->accesses.size();
+    unsigned long n = 0;
+    epicsTimeStamp start, end;
+    asynStatus status;
+
+    epicsEventMustWait(startEvent);
+    /* Let the other threads through */
+    epicsEventSignal(startEvent);
+
+    /* Threads start at different accesses so they do not all hit the
+     * same register in lockstep */
+    for (n = thread->id; numAccesses > 0 && !epicsAtomicGetIntT(&stopFlag); ++n) {
+        benchAccess_t *access = &thread->accesses[n % numAccesses];
+        const benchParam_t *param = access->param;
+        int write = param->write;
+        epicsUInt32 value = 0;
+
+        epicsTimeGetCurrent(&start);
+        if (write) {
+            value = param->value + ((n / numAccesses) & 1)*param->step;
+            status = pasynUInt32DigitalSyncIO->write(access->pasynUser,
+                    value, 0xFFFFFFFF, BENCH_IO_TIMEOUT);
+            if (status == asynSuccess && param->readback) {
+                status = benchReadback(access, value, &start);
+            }
+        }
+        else {
+            status = pasynUInt32DigitalSyncIO->read(access->pasynUser,
+                    &value, 0xFFFFFFFF, BENCH_IO_TIMEOUT);
+        }
+        epicsTimeGetCurrent(&end);
+
+        if (status != asynSuccess) {
+            thread->errors[write]++;
+            continue;
+        }
+        thread->lat[write].push_back(epicsTimeDiffInSeconds(&end, &start)*1e6);
+    }
+
+    epicsEventSignal(thread->doneEvent);
+}
+
+static void benchBurstTask (void *pvt)
+{
+    benchThread_t *thread = (benchThread_t *)pvt;
+    size_t numAccesses = thread->accesses.size();
+    std::vector<epicsTimeStamp> starts(numAccesses);
+    std::vector<epicsUInt32> values(numAccesses);
+    std::vector<asynStatus> writeStatus(numAccesses);
+    unsigned long round = 0;
+    epicsTimeStamp end;
+    asynStatus status;
+    size_t k;
+
+    epicsEventMustWait(startEvent);
+    /* Let the other threads through */
+    epicsEventSignal(startEvent);
+
+    for (round = 0; numAccesses > 0 && !epicsAtomicGetIntT(&stopFlag); ++round) {
+        for (k = 0; k < numAccesses; ++k) {
+            const benchParam_t *param = thread->accesses[k].param;
+
+            values[k] = param->value + (round & 1)*param->step;
+            epicsTimeGetCurrent(&starts[k]);
+            writeStatus[k] = pasynUInt32DigitalSyncIO->write(
+                    thread->accesses[k].pasynUser, values[k], 0xFFFFFFFF,
+                    BENCH_IO_TIMEOUT);
+        }
+
+        for (k = 0; k < numAccesses; ++k) {
+            status = writeStatus[k];
+            if (status == asynSuccess) {
+                status = benchReadback(&thread->accesses[k], values[k], &starts[k]);
+            }
+            epicsTimeGetCurrent(&end);
+
+            if (status != asynSuccess) {
+                thread->errors[1]++;
+                continue;
+            }
+            thread->lat[1].push_back(epicsTimeDiffInSeconds(&end, &starts[k])*1e6);
+        }
+    }
+
+    epicsEventSignal(thread->doneEvent);
+}
+
+/* Set the float64 parameter drvInfo of portName */
+static asynStatus benchSetDouble (const char *portName, const char *drvInfo,
+        double value)
+{
+    asynUser *pasynUser = NULL;
+    asynStatus status;
+
+    status = pasynFloat64SyncIO->connect(portName, 0, &pasynUser, drvInfo);
+    if (status != asynSuccess) {
+        return status;
+    }
+    status = pasynFloat64SyncIO->write(pasynUser, value, BENCH_IO_TIMEOUT);
+    pasynFloat64SyncIO->disconnect(pasynUser);
+
+    return status;
+}
+
+/* Run one class at one concurrency against portName and append the
+ * results to fp. Returns 0 on success */
+static int benchRun (FILE *fp, const char *portName, const benchClass_t *cls,
+        int concurrency, int numWorkers, double duration, int verbose)
+{
+    const char *benchClass = cls->name;
+    std::vector<benchThread_t> threads(concurrency);
+    std::vector<double> lat[2];
+    unsigned long errors[2] = {0, 0};
+    epicsTimeStamp start, end;
+    double elapsed;
+    char threadName[32];
+    int err = 0;
+    int i;
+    size_t j;
+    int addr;
+    int numWrites;
+
+    for (i = 0; i < concurrency; ++i) {
+        benchThread_t *thread = &threads[i];
+
+        thread->id = i;
+        thread->errors[0] = thread->errors[1] = 0;
+        thread->doneEvent = epicsEventMustCreate(epicsEventEmpty);
+        numWrites = 0;
+        for (j = 0; j < NUM_BENCH_PARAMS; ++j) {
+            const benchParam_t *param = &benchParams[j];
+
+            if (strcmp(param->benchClass, benchClass) != 0) {
+                continue;
+            }
+            for (addr = 0; addr < param->numAddr; ++addr) {
+                benchAccess_t access;
+
+                if (param->write && numWrites++ % concurrency != i) {
+                    continue;
+                }
+
+                access.param = param;
+                access.addr = addr;
+                if (pasynUInt32DigitalSyncIO->connect(portName, addr,
+                            &access.pasynUser, param->drvInfo) != asynSuccess) {
+                    fprintf(stderr, "TimRxBench: could not connect to %s, addr %d, %s\n",
+                            portName, addr, param->drvInfo);
+                    err = -1;
+                    goto connect_err;
+                }
+                thread->accesses.push_back(access);
+            }
+        }
+    }
+
+    if (cls->burst && (benchSetDouble(portName, "TIM_RX_SHADOW_TTL",
+                    BENCH_BURST_SHADOW_TTL) != asynSuccess ||
+                benchSetDouble(portName, "TIM_RX_WRITE_HOLDOFF",
+                    BENCH_BURST_HOLDOFF) != asynSuccess)) {
+        fprintf(stderr, "TimRxBench: could not set up burst writes on %s\n", portName);
+        err = -1;
+        goto connect_err;
+    }
+
+    epicsAtomicSetIntT(&stopFlag, 0);
+    for (i = 0; i < concurrency; ++i) {
+        epicsSnprintf(threadName, sizeof(threadName), "benchClient%d", i);
+        epicsThreadCreate(threadName, epicsThreadPriorityMedium,
+                epicsThreadGetStackSize(epicsThreadStackMedium),
+                cls->burst? benchBurstTask : benchTask, &threads[i]);
+    }
+
+    epicsTimeGetCurrent(&start);
+    epicsEventSignal(startEvent);
+    epicsThreadSleep(duration);
+    epicsAtomicSetIntT(&stopFlag, 1);
+    for (i = 0; i < concurrency; ++i) {
+        epicsEventMustWait(threads[i].doneEvent);
+    }
+    epicsTimeGetCurrent(&end);
+    /* Consume the event the last thread passed on */
+    epicsEventTryWait(startEvent);
+    elapsed = epicsTimeDiffInSeconds(&end, &start);
+
+    if (cls->burst) {
+        benchSetDouble(portName, "TIM_RX_WRITE_HOLDOFF", 0.0);
+        benchSetDouble(portName, "TIM_RX_SHADOW_TTL", 0.0);
+    }
+
+    for (i = 0; i < concurrency; ++i) {
+        for (int op = 0; op < 2; ++op) {
+            lat[op].insert(lat[op].end(), threads[i].lat[op].begin(),
+                    threads[i].lat[op].end());
+            errors[op] += threads[i].errors[op];
+        }
+    }
+
+    for (int op = 0; op < 2; ++op) {
+        const char *opName = op ? "write" : "read";
+        double opsPerSec;
+
+        if (lat[op].empty() && errors[op] == 0) {
+            continue;
+        }
+        std::sort(lat[op].begin(), lat[op].end());
+        opsPerSec = elapsed > 0.0 ? (double)lat[op].size()/elapsed : 0.0;
+
+        printf("%-9s %-6s conc %3d workers %2d: %10.0f ops/s, "
+                "p50 %8.1f us, p99 %8.1f us, p999 %8.1f us, errors %lu\n",
+                benchClass, opName, concurrency, numWorkers, opsPerSec,
+                percentile(lat[op], 0.50), percentile(lat[op], 0.99),
+                percentile(lat[op], 0.999), errors[op]);
+        fprintf(fp, "%s,%s,%d,%d,%lu,%.3f,%.1f,%.1f,%.1f,%.1f,%.1f,%lu\n",
+                benchClass, opName, concurrency, numWorkers,
+                (unsigned long)lat[op].size(), elapsed, opsPerSec,
+                percentile(lat[op], 0.50), percentile(lat[op], 0.99),
+                percentile(lat[op], 0.999),
+                lat[op].empty() ? 0.0 : lat[op].back(), errors[op]);
+    }
+    fflush(fp);
+
+    if (verbose) {
+        printf("%s: %d threads ran for %.3f s\n", benchClass, concurrency,
+                elapsed);
+    }
+
+connect_err:
+    for (i = 0; i < concurrency; ++i) {
+        for (j = 0; j < threads[i].accesses.size(); ++j) {
+            pasynUInt32DigitalSyncIO->disconnect(threads[i].accesses[j].pasynUser);
+        }
+        if (threads[i].doneEvent) {
+            epicsEventDestroy(threads[i].doneEvent);
+        }
+    }
+    return err;
+}
+
+int main (int argc, char *argv [])
+{
+    int err = 0;
+    int verbose = 0;
+    const char *endpoint = DFLT_ENDPOINT;
+    const char *output = DFLT_OUTPUT;
+    const char *onlyClass = NULL;
+    double duration = DFLT_DURATION;
+    int concurrency[MAX_LIST];
+    int workers[MAX_LIST];
+    int numConcurrency;
+    int numWorkers;
+    char portName[64];
+    FILE *fp = NULL;
+    int i;
+    int w;
+    int c;
+    size_t k;
+
+    numConcurrency = parseList(DFLT_CONCURRENCY, concurrency, MAX_LIST);
+    numWorkers = parseList(DFLT_WORKERS, workers, MAX_LIST);
+
+    for (i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-v") == 0) {
+            verbose = 1;
+        }
+        else if (strcmp(argv[i], "-h") == 0) {
+            print_help (argv [0]);
+            return 0;
+        }
+        else if (i+1 >= argc) {
+            print_help (argv [0]);
+            return 1;
+        }
+        else if (strcmp(argv[i], "-c") == 0) {
+            numConcurrency = parseList(argv[++i], concurrency, MAX_LIST);
+        }
+        else if (strcmp(argv[i], "-w") == 0) {
+            numWorkers = parseList(argv[++i], workers, MAX_LIST);
+        }
+        else if (strcmp(argv[i], "-d") == 0) {
+            duration = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-k") == 0) {
+            onlyClass = argv[++i];
+        }
+        else if (strcmp(argv[i], "-b") == 0) {
+            endpoint = argv[++i];
+        }
+        else if (strcmp(argv[i], "-o") == 0) {
+            output = argv[++i];
+        }
+        else {
+            print_help (argv [0]);
+            return 1;
+        }
+    }
+
+    if (numConcurrency <= 0 || numWorkers <= 0 || numWorkers > BENCH_MAX_PORTS ||
+            duration <= 0.0) {
+        fprintf(stderr, "TimRxBench: invalid options\n");
+        print_help (argv [0]);
+        return 1;
+    }
+
+    fp = fopen(output, "w");
+    if (fp == NULL) {
+        fprintf(stderr, "TimRxBench: could not open %s\n", output);
+        err = 1;
+        goto fopen_err;
+    }
+    fprintf(fp, "class,op,concurrency,workers,ops,seconds,ops_per_s,"
+            "p50_us,p99_us,p999_us,max_us,errors\n");
+
+    startEvent = epicsEventMustCreate(epicsEventEmpty);
+
+    /* One port per worker count. Receivers 2n+1 and 2n+2 share a board
+     * and so its HALCS clients, so each port takes the first receiver of
+     * a different board to get its own clients and write workers */
+    for (w = 0; w < numWorkers; ++w) {
+        epicsSnprintf(portName, sizeof(portName), "%s%d", BENCH_PORT_PREFIX, w);
+        drvTimRxConfigure(portName, endpoint, 2*w+1, verbose, DFLT_TIMEOUT,
+                workers[w]);
+
+        for (k = 0; k < NUM_BENCH_CLASSES; ++k) {
+            if (onlyClass != NULL && strcmp(onlyClass, benchClasses[k].name) != 0) {
+                continue;
+            }
+            for (c = 0; c < numConcurrency; ++c) {
+                if (benchRun(fp, portName, &benchClasses[k], concurrency[c],
+                            workers[w], duration, verbose) != 0) {
+                    err = 1;
+                    goto bench_err;
+                }
+            }
+        }
+    }
+
+    printf("TimRxBench: results written to %s\n", output);
+
+bench_err:
+    fclose(fp);
+fopen_err:
+    /* Runs the driver exit handlers, which stop its threads */
+    epicsExit(err);
+    return err;
+}
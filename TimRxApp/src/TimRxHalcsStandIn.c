@@ -0,0 +1,398 @@
+/*
+ * TimRxHalcsStandIn.c
+ *
+ * In-memory stand-in for the parts of the HALCS client library used by
+ * drvTimRx, so the IOC can run with no AFC board nor HALCS broker. It is
+ * linked instead of halcsclient when HALCS_STANDIN is YES, see the
+ * Makefile.
+ *
+ * Registers are kept per service name, so every client of a board sees
+ * the writes of the others. Each call takes a transport latency, run
+ * concurrently by all clients, plus a service time, run one call at a
+ * time per service as the HALCS SMIO thread does. Both are set, with
+ * error and timeout injection, by environment variables read when the
+ * first client is created:
+ *
+ * HALCS_STANDIN_LATENCY       Transport latency of each call, in seconds
+ * HALCS_STANDIN_JITTER        Random extra latency, up to this, in seconds
+ * HALCS_STANDIN_SERVICE_TIME  Service time of each call, in seconds
+ * HALCS_STANDIN_ERROR_RATE    Fraction of calls failing with a server error
+ * HALCS_STANDIN_TIMEOUT_RATE  Fraction of calls failing with a timeout,
+ *                             after waiting for the client timeout
+ * HALCS_STANDIN_EVT_RATE      Rate the event counters run at, in Hz
+ * HALCS_STANDIN_SEED          Seed of the injected errors and jitter
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include <epicsTypes.h>
+#include <epicsTime.h>
+#include <epicsThread.h>
+#include <epicsMutex.h>
+#include <epicsString.h>
+#include <halcs_client.h>
+
+#define STANDIN_MAX_DEVICES         64
+#define STANDIN_MAX_CHAN            8
+#define STANDIN_SERVICE_SIZE        128
+/* Client timeout used if none is given, in milliseconds */
+#define STANDIN_TIMEOUT_DFLT        1000
+
+/* Registers of the AFC timing SMIO, with their reset value */
+#define STANDIN_REGS(X) \
+    X(link_status, 1) \
+    X(rxen_status, 1) \
+    X(ref_clk_locked, 1) \
+    X(evren, 0) \
+    X(alive, 1) \
+    X(rtm_freq_kp, 0) \
+    X(rtm_freq_ki, 0) \
+    X(rtm_phase_kp, 0) \
+    X(rtm_phase_ki, 0) \
+    X(rtm_phase_navg, 0) \
+    X(rtm_phase_div_exp, 0) \
+    X(rtm_rfreq_hi, 0) \
+    X(rtm_rfreq_lo, 0) \
+    X(rtm_n1, 0) \
+    X(rtm_hs_div, 0) \
+    X(afc_freq_kp, 0) \
+    X(afc_freq_ki, 0) \
+    X(afc_phase_kp, 0) \
+    X(afc_phase_ki, 0) \
+    X(afc_phase_navg, 0) \
+    X(afc_phase_div_exp, 0) \
+    X(afc_rfreq_hi, 0) \
+    X(afc_rfreq_lo, 0) \
+    X(afc_n1, 0) \
+    X(afc_hs_div, 0)
+
+/* Per channel registers of each trigger bank. count and count_rst are
+ * handled apart, see standInCount */
+#define STANDIN_CHAN_REGS(X, BANK) \
+    X(BANK##_en) \
+    X(BANK##_pol) \
+    X(BANK##_log) \
+    X(BANK##_itl) \
+    X(BANK##_src) \
+    X(BANK##_dir) \
+    X(BANK##_pulses) \
+    X(BANK##_evt) \
+    X(BANK##_dly) \
+    X(BANK##_wdt) \
+    X(BANK##_count) \
+    X(BANK##_count_rst)
+
+#define STANDIN_REG_ID(name, reset) standInReg_##name,
+#define STANDIN_CHAN_REG_ID(name) standInReg_##name,
+
+typedef enum {
+    STANDIN_REGS(STANDIN_REG_ID)
+    STANDIN_CHAN_REGS(STANDIN_CHAN_REG_ID, amc)
+    STANDIN_CHAN_REGS(STANDIN_CHAN_REG_ID, fmc1)
+    STANDIN_CHAN_REGS(STANDIN_CHAN_REG_ID, fmc2)
+    standInNumRegs
+} standInReg_e;
+
+/* Registers of one service. Event counters run from countBase */
+typedef struct {
+    char service[STANDIN_SERVICE_SIZE];
+    epicsMutexId lock;
+    /* Serializes the service time of the calls */
+    epicsMutexId serviceLock;
+    epicsUInt32 regs[standInNumRegs][STANDIN_MAX_CHAN];
+    epicsTimeStamp countBase[standInNumRegs][STANDIN_MAX_CHAN];
+} standInDevice_t;
+
+struct _halcs_client_t {
+    char *endpoint;
+    int timeout;
+    /* State of the error and jitter generator. Clients are not used by
+     * several threads at once, so it needs no lock */
+    epicsUInt32 rng;
+};
+
+typedef struct {
+    double latency;
+    double jitter;
+    double serviceTime;
+    double errorRate;
+    double timeoutRate;
+    double evtRate;
+    epicsUInt32 seed;
+} standInConfig_t;
+
+static standInConfig_t standInConfig;
+static standInDevice_t *standInDevices[STANDIN_MAX_DEVICES];
+static int standInNumDevices = 0;
+static epicsUInt32 standInNumClients = 0;
+static epicsMutexId standInLock = NULL;
+static epicsThreadOnceId standInOnceId = EPICS_THREAD_ONCE_INIT;
+
+static double standInEnvDouble(const char *name, double dflt)
+{
+    const char *value = getenv(name);
+
+    return (value != NULL && *value != '\0')? atof(value) : dflt;
+}
+
+static void standInOnce(void *arg)
+{
+    standInLock = epicsMutexMustCreate();
+
+    standInConfig.latency = standInEnvDouble("HALCS_STANDIN_LATENCY", 0.0);
+    standInConfig.jitter = standInEnvDouble("HALCS_STANDIN_JITTER", 0.0);
+    standInConfig.serviceTime = standInEnvDouble("HALCS_STANDIN_SERVICE_TIME", 0.0);
+    standInConfig.errorRate = standInEnvDouble("HALCS_STANDIN_ERROR_RATE", 0.0);
+    standInConfig.timeoutRate = standInEnvDouble("HALCS_STANDIN_TIMEOUT_RATE", 0.0);
+    standInConfig.evtRate = standInEnvDouble("HALCS_STANDIN_EVT_RATE", 0.0);
+    standInConfig.seed = (epicsUInt32) standInEnvDouble("HALCS_STANDIN_SEED", 1.0);
+}
+
+/* Uniform in [0, 1) */
+static double standInRandom(halcs_client_t *self)
+{
+    /* xorshift32 */
+    self->rng ^= self->rng << 13;
+    self->rng ^= self->rng >> 17;
+    self->rng ^= self->rng << 5;
+
+    return self->rng/4294967296.0;
+}
+
+/* Find the registers of a service, creating them on first use */
+static standInDevice_t *standInGetDevice(const char *service)
+{
+    standInDevice_t *device = NULL;
+    int i = 0;
+
+#define STANDIN_REG_RESET(name, reset) \
+    for (i = 0; i < STANDIN_MAX_CHAN; ++i) { \
+        device->regs[standInReg_##name][i] = reset; \
+    }
+
+    epicsMutexMustLock(standInLock);
+    for (i = 0; i < standInNumDevices; ++i) {
+        if (strcmp(standInDevices[i]->service, service) == 0) {
+            device = standInDevices[i];
+            goto device_found;
+        }
+    }
+
+    if (standInNumDevices == STANDIN_MAX_DEVICES) {
+        goto too_many_devices_err;
+    }
+
+    device = (standInDevice_t *) calloc(1, sizeof(*device));
+    if (device == NULL) {
+        goto alloc_device_err;
+    }
+
+    strncpy(device->service, service, sizeof(device->service) - 1);
+    device->lock = epicsMutexMustCreate();
+    device->serviceLock = epicsMutexMustCreate();
+    STANDIN_REGS(STANDIN_REG_RESET)
+    for (i = 0; i < standInNumRegs; ++i) {
+        for (int chan = 0; chan < STANDIN_MAX_CHAN; ++chan) {
+            epicsTimeGetCurrent(&device->countBase[i][chan]);
+        }
+    }
+
+    standInDevices[standInNumDevices++] = device;
+
+device_found:
+alloc_device_err:
+too_many_devices_err:
+    epicsMutexUnlock(standInLock);
+    return device;
+}
+
+/* Simulate the transport and service of one call and pick its outcome */
+static halcs_client_err_e standInCall(halcs_client_t *self, standInDevice_t *device)
+{
+    double latency = standInConfig.latency + standInConfig.jitter*standInRandom(self);
+    double fate = standInRandom(self);
+
+    if (fate < standInConfig.timeoutRate) {
+        epicsThreadSleep(self->timeout*1e-3);
+        return HALCS_CLIENT_ERR_TIMEOUT;
+    }
+
+    if (latency > 0.0) {
+        epicsThreadSleep(latency);
+    }
+
+    if (standInConfig.serviceTime > 0.0) {
+        epicsMutexMustLock(device->serviceLock);
+        epicsThreadSleep(standInConfig.serviceTime);
+        epicsMutexUnlock(device->serviceLock);
+    }
+
+    if (fate < standInConfig.timeoutRate + standInConfig.errorRate) {
+        return HALCS_CLIENT_ERR_SERVER;
+    }
+
+    return HALCS_CLIENT_SUCCESS;
+}
+
+/* Event counters count at HALCS_STANDIN_EVT_RATE from their last reset.
+ * A non-zero write to count_rst resets them. Must be called with the
+ * device lock held */
+static epicsUInt32 standInCount(standInDevice_t *device, int reg, uint32_t chan)
+{
+    epicsTimeStamp now;
+
+    epicsTimeGetCurrent(&now);
+    return device->regs[reg][chan] + (epicsUInt32) (standInConfig.evtRate*
+            epicsTimeDiffInSeconds(&now, &device->countBase[reg][chan]));
+}
+
+static halcs_client_err_e standInAccess(halcs_client_t *self, char *service,
+        int reg, uint32_t chan, uint32_t *value, int write)
+{
+    standInDevice_t *device = NULL;
+    halcs_client_err_e err = HALCS_CLIENT_SUCCESS;
+    int countReg = -1;
+
+    if (self == NULL || service == NULL || chan >= STANDIN_MAX_CHAN) {
+        return HALCS_CLIENT_ERR_INV_PARAM;
+    }
+
+    device = standInGetDevice(service);
+    if (device == NULL) {
+        return HALCS_CLIENT_ERR_ALLOC;
+    }
+
+    err = standInCall(self, device);
+    if (err != HALCS_CLIENT_SUCCESS) {
+        return err;
+    }
+
+    if (reg == standInReg_amc_count || reg == standInReg_fmc1_count ||
+            reg == standInReg_fmc2_count) {
+        countReg = reg;
+    }
+    else if (reg == standInReg_amc_count_rst || reg == standInReg_fmc1_count_rst ||
+            reg == standInReg_fmc2_count_rst) {
+        /* count_rst follows count in each bank */
+        countReg = reg - 1;
+    }
+
+    epicsMutexMustLock(device->lock);
+    if (write) {
+        device->regs[reg][chan] = *value;
+        if (reg == countReg) {
+            epicsTimeGetCurrent(&device->countBase[reg][chan]);
+        }
+        else if (countReg >= 0 && *value != 0) {
+            device->regs[countReg][chan] = 0;
+            epicsTimeGetCurrent(&device->countBase[countReg][chan]);
+        }
+    }
+    else if (reg == countReg) {
+        *value = standInCount(device, reg, chan);
+    }
+    else {
+        *value = device->regs[reg][chan];
+    }
+    epicsMutexUnlock(device->lock);
+
+    return HALCS_CLIENT_SUCCESS;
+}
+
+halcs_client_t *halcs_client_new_time (char *broker_endp, int verbose,
+        const char *log_file_name, int timeout)
+{
+    halcs_client_t *self = NULL;
+
+    epicsThreadOnce(&standInOnceId, standInOnce, NULL);
+
+    self = (halcs_client_t *) calloc(1, sizeof(*self));
+    if (self == NULL) {
+        return NULL;
+    }
+
+    self->endpoint = epicsStrDup((broker_endp != NULL)? broker_endp : "");
+    self->timeout = (timeout > 0)? timeout : STANDIN_TIMEOUT_DFLT;
+
+    epicsMutexMustLock(standInLock);
+    self->rng = standInConfig.seed + 0x9E3779B9u*(++standInNumClients);
+    epicsMutexUnlock(standInLock);
+    if (self->rng == 0) {
+        self->rng = 1;
+    }
+
+    if (verbose) {
+        printf("HALCS stand-in: client for %s\n", self->endpoint);
+    }
+
+    return self;
+}
+
+halcs_client_t *halcs_client_new (char *broker_endp, int verbose,
+        const char *log_file_name)
+{
+    return halcs_client_new_time(broker_endp, verbose, log_file_name,
+            STANDIN_TIMEOUT_DFLT);
+}
+
+void halcs_client_destroy (halcs_client_t **self_p)
+{
+    if (self_p == NULL || *self_p == NULL) {
+        return;
+    }
+
+    free((*self_p)->endpoint);
+    free(*self_p);
+    *self_p = NULL;
+}
+
+const char *halcs_client_err_str (halcs_client_err_e err)
+{
+    switch (err) {
+        case HALCS_CLIENT_SUCCESS:
+            return "Success";
+        case HALCS_CLIENT_ERR_ALLOC:
+            return "Could not allocate message";
+        case HALCS_CLIENT_ERR_SERVER:
+            return "Server could not complete request";
+        case HALCS_CLIENT_ERR_TIMEOUT:
+            return "Timeout receiving message";
+        case HALCS_CLIENT_ERR_INV_PARAM:
+            return "Invalid function parameter";
+        default:
+            return "Unknown error";
+    }
+}
+
+/* Accessors of the single registers */
+#define STANDIN_REG_FUNCS(name, reset) \
+    halcs_client_err_e afc_timing_set_##name (halcs_client_t *self, char *service, \
+            uint32_t value) \
+    { \
+        return standInAccess(self, service, standInReg_##name, 0, &value, 1); \
+    } \
+    halcs_client_err_e afc_timing_get_##name (halcs_client_t *self, char *service, \
+            uint32_t *value) \
+    { \
+        return standInAccess(self, service, standInReg_##name, 0, value, 0); \
+    }
+
+/* Accessors of the per channel registers */
+#define STANDIN_CHAN_REG_FUNCS(name) \
+    halcs_client_err_e halcs_set_afc_timing_##name (halcs_client_t *self, char *service, \
+            uint32_t chan, uint32_t value) \
+    { \
+        return standInAccess(self, service, standInReg_##name, chan, &value, 1); \
+    } \
+    halcs_client_err_e halcs_get_afc_timing_##name (halcs_client_t *self, char *service, \
+            uint32_t chan, uint32_t *value) \
+    { \
+        return standInAccess(self, service, standInReg_##name, chan, value, 0); \
+    }
+
+STANDIN_REGS(STANDIN_REG_FUNCS)
+STANDIN_CHAN_REGS(STANDIN_CHAN_REG_FUNCS, amc)
+STANDIN_CHAN_REGS(STANDIN_CHAN_REG_FUNCS, fmc1)
+STANDIN_CHAN_REGS(STANDIN_CHAN_REG_FUNCS, fmc2)
@@ -0,0 +1,707 @@
+/* Micro benchmarks of drvTimRx. Each mode times one path of the driver
+ * on its own, apart from asyn and the broker round trip.
+ *
+ * Modes, selected with -m:
+ *   names  Times the per-call formatting of HALCS service names against
+ *          the lookup of the names resolved at construction
+ *   dispatch  Times the lookup of the HALCS function of a parameter in
+ *          the parameter registry against the unordered_map and any_cast
+ *          dispatch drvTimRx used before it
+ *   crate  Peak RSS and CPU time of one process serving a whole crate
+ *          with drvTimRxConfigureCrate, against one process per receiver.
+ *          Each process runs this program in serve mode for -d seconds
+ *   serve  Serves the receivers given with -r for -d seconds
+ *   si57x  Checks the Si57x solver against a brute force search over the
+ *          whole output range and times both
+ *
+ * The modes that create drvTimRx ports need a broker at the endpoint given
+ * with -b, unless built with HALCS_STANDIN set to YES, which links
+ * TimRxHalcsStandIn instead of the HALCS client library. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#include <vector>
+#include <unordered_map>
+#include <typeinfo>
+
+#include <epicsTypes.h>
+#include <epicsTime.h>
+#include <epicsThread.h>
+#include <epicsExit.h>
+#include <epicsStdio.h>
+#include <asynDriver.h>
+
+#include "Si57x.h"
+#include "drvTimRx.h"
+
+#define DFLT_ENDPOINT               "ipc:///tmp/malamute"
+#define DFLT_TIMEOUT                2000
+#define DFLT_DURATION               10.0
+#define DFLT_WORKERS                1
+#define BENCH_PORT_PREFIX           "TIM_RX_MICRO"
+/* Lookups of each parameter per timed path */
+#define BENCH_MICRO_ROUNDS          20000
+/* Upper bound of the parameter indexes searched for hardware functions */
+#define BENCH_MAX_PARAMS            1024
+/* Receiver of the port the micro benchmarks use */
+#define BENCH_MICRO_TIM_RX          1
+#define BENCH_SERVICE_NAME_SIZE     50
+/* The HALCS service drvTimRx talks to */
+#define BENCH_SERVICE               "LNLS_AFC_TIMING"
+/* Receivers of a full crate, as passed to drvTimRxConfigureCrate */
+#define BENCH_CRATE_LIST            "1-24"
+#define BENCH_CRATE_SIZE            24
+/* Frequencies timed, and checked by default, in si57x mode */
+#define BENCH_SI57X_POINTS          1000000
+
+/* Defined in drvTimRx.cpp */
+extern "C" int drvTimRxConfigure(const char *portName, const char *endpoint,
+        int timRxNumber, int verbose, int timeout, int numWorkers);
+extern "C" int drvTimRxConfigureCrate(const char *portPrefix, const char *endpoint,
+        const char *timRxList, int verbose, int timeout, int numWorkers);
+
+static void print_help (const char *program_name)
+{
+    printf( "Usage: %s -m <mode> [options]\n"
+            "\t-h This help message\n"
+            "\t-v Verbose output\n"
+            "\t-m <mode> Benchmark mode [names|dispatch|crate|serve|si57x]\n"
+            "\t-b <endpoint> Broker endpoint passed to the driver (default %s)\n"
+            "\t-d <seconds> crate and serve modes: time to serve (default %.1f)\n"
+            "\t-r <list> serve mode: receivers to serve, as in \"1-24\"\n"
+            "\t-w <workers> crate and serve modes: write workers of each port (default %d)\n"
+            "\t-s <Hz> si57x mode: step between checked frequencies. 1 checks every\n"
+            "\t        frequency (default: %d frequencies over the range)\n"
+            , program_name, DFLT_ENDPOINT, DFLT_DURATION, DFLT_WORKERS, BENCH_SI57X_POINTS);
+}
+
+/* Create the port of the micro benchmarks. Returns NULL on failure */
+static drvTimRx *benchMicroPort (const char *endpoint, int verbose)
+{
+    const char *portName = BENCH_PORT_PREFIX;
+    drvTimRx *pDrv = NULL;
+
+    drvTimRxConfigure(portName, endpoint, BENCH_MICRO_TIM_RX, verbose,
+            DFLT_TIMEOUT, 1);
+    pDrv = (drvTimRx *) findAsynPortDriver(portName);
+    if (pDrv == NULL) {
+        fprintf(stderr, "TimRxMicroBench: could not create port %s\n", portName);
+    }
+
+    return pDrv;
+}
+
+static double benchNsPerOp (const epicsTimeStamp *start, const epicsTimeStamp *end,
+        double ops)
+{
+    return (ops > 0.0)? epicsTimeDiffInSeconds(end, start)*1e9/ops : 0.0;
+}
+
+/* Full HALCS service name of every hardware parameter, formatted on each
+ * call as every hardware access used to, against the lookup of the names
+ * drvTimRx resolves at construction */
+static int benchNames (const char *endpoint, int verbose)
+{
+    std::vector<int> functionIds;
+    char service[BENCH_SERVICE_NAME_SIZE];
+    epicsTimeStamp start, end;
+    double ops = 0.0;
+    double formatNs = 0.0;
+    double lookupNs = 0.0;
+    volatile char sink = 0;
+    drvTimRx *pDrv = NULL;
+
+    pDrv = benchMicroPort(endpoint, verbose);
+    if (pDrv == NULL) {
+        return 1;
+    }
+
+    /* getServiceName returns NULL past the last parameter */
+    for (int functionId = 0; functionId < BENCH_MAX_PARAMS; ++functionId) {
+        if (pDrv->getServiceName(functionId) != NULL) {
+            functionIds.push_back(functionId);
+        }
+    }
+    ops = double(functionIds.size())*BENCH_MICRO_ROUNDS;
+
+    /* Both must give the same names */
+    for (size_t i = 0; i < functionIds.size(); ++i) {
+        const char *lookup = pDrv->getServiceName(functionIds[i]);
+
+        pDrv->getFullServiceName(BENCH_MICRO_TIM_RX, 0, BENCH_SERVICE,
+                service, sizeof(service));
+        if (lookup == NULL || strcmp(lookup, service) != 0) {
+            fprintf(stderr, "TimRxMicroBench: service names differ: %s and %s\n",
+                    service, lookup? lookup : "(none)");
+            return 1;
+        }
+    }
+
+    epicsTimeGetCurrent(&start);
+    for (int r = 0; r < BENCH_MICRO_ROUNDS; ++r) {
+        for (size_t i = 0; i < functionIds.size(); ++i) {
+            pDrv->getFullServiceName(BENCH_MICRO_TIM_RX, 0, BENCH_SERVICE,
+                    service, sizeof(service));
+            sink += service[0];
+        }
+    }
+    epicsTimeGetCurrent(&end);
+    formatNs = benchNsPerOp(&start, &end, ops);
+
+    epicsTimeGetCurrent(&start);
+    for (int r = 0; r < BENCH_MICRO_ROUNDS; ++r) {
+        for (size_t i = 0; i < functionIds.size(); ++i) {
+            sink += pDrv->getServiceName(functionIds[i])[0];
+        }
+    }
+    epicsTimeGetCurrent(&end);
+    lookupNs = benchNsPerOp(&start, &end, ops);
+
+    printf("names: %u parameters, %.0f lookups each way\n",
+            (unsigned) functionIds.size(), ops);
+    printf("names: snprintf per call %8.1f ns/op\n", formatNs);
+    printf("names: interned lookup   %8.1f ns/op\n", lookupNs);
+
+    return 0;
+}
+
+/* Copy of the dispatch drvTimRx used before its parameter registry, kept
+ * to compare against. benchAny stands for linb::any, which held these
+ * function tables on the heap, as they do not fit its two pointer buffer,
+ * and whose any_cast returned a copy */
+class benchAny {
+    public:
+        template<typename T>
+            benchAny(const T &value) : content(new holder<T>(value)) {}
+        benchAny(const benchAny &other) :
+            content(other.content? other.content->clone() : NULL) {}
+        ~benchAny() { delete content; }
+
+        const std::type_info &type() const
+        {
+            return content? content->type() : typeid(void);
+        }
+
+        struct placeholder {
+            virtual ~placeholder() {}
+            virtual const std::type_info &type() const = 0;
+            virtual placeholder *clone() const = 0;
+        };
+
+        template<typename T>
+        struct holder : public placeholder {
+            holder(const T &value) : held(value) {}
+            const std::type_info &type() const { return typeid(T); }
+            placeholder *clone() const { return new holder(held); }
+            T held;
+        };
+
+        placeholder *content;
+
+    private:
+        benchAny &operator=(const benchAny &);
+};
+
+template<typename T>
+static T benchAnyCast(const benchAny &operand)
+{
+    if (operand.type() != typeid(T)) {
+        throw std::bad_cast();
+    }
+    return static_cast<benchAny::holder<T> *>(operand.content)->held;
+}
+
+/* Stands for doExecuteHwReadFunction, which both dispatches end in */
+static volatile unsigned long benchDispatched = 0;
+
+template<typename T>
+static asynStatus benchDispatchRead (const T &func)
+{
+    benchDispatched += (func.read != NULL);
+    return asynSuccess;
+}
+
+/* functionsAny_t as it was, with the read and service name paths */
+struct benchFunctionsAny_t {
+    template<typename T>
+        benchFunctionsAny_t(T const& functionFp) :
+            _functionFp(functionFp),
+            _executeHwReadFunction(&benchFunctionsAny_t::executeHwReadFunction<T>),
+            _getServiceNameFromFunc(&benchFunctionsAny_t::getServiceNameFromFunc<T>) {}
+
+    asynStatus executeHwRead()
+    {
+        return (this->*_executeHwReadFunction)(_functionFp);
+    }
+
+    const char *getServiceName()
+    {
+        return (this->*_getServiceNameFromFunc)(_functionFp);
+    }
+
+private:
+    benchAny _functionFp;
+    typedef asynStatus (benchFunctionsAny_t::*executeHwReadFunctionFp)
+        (const benchAny& functionFp);
+    executeHwReadFunctionFp _executeHwReadFunction;
+    typedef const char * (benchFunctionsAny_t::*getServiceNameFromFuncFp)
+        (const benchAny& functionFp) const;
+    getServiceNameFromFuncFp _getServiceNameFromFunc;
+
+    template<typename T>
+    asynStatus executeHwReadFunction(const benchAny& functionFp)
+    {
+        if(!benchAnyCast<T>(functionFp).read) {
+            return asynSuccess;
+        }
+        auto functionFpCast = benchAnyCast<T>(functionFp);
+        return benchDispatchRead(functionFpCast);
+    }
+
+    template<typename T>
+    const char *getServiceNameFromFunc(const benchAny& functionFp) const
+    {
+        auto functionFpCast = benchAnyCast<T>(functionFp);
+        return functionFpCast.serviceName;
+    }
+};
+
+/* The registry lookup of executeHwReadFunction up to the HALCS call */
+static asynStatus benchRegistryRead (const drvTimRx *pDrv, int functionId,
+        const char **service)
+{
+    const functionsHw_t *func = pDrv->getHwFunc(functionId);
+
+    if (func == NULL) {
+        return asynDisabled;
+    }
+    *service = pDrv->getServiceName(functionId);
+
+    switch (func->type) {
+        case functionsHwInt32:
+            return benchDispatchRead(func->int32);
+        case functionsHwInt32Chan:
+            return benchDispatchRead(func->int32Chan);
+        case functionsHwFloat64:
+            return benchDispatchRead(func->float64);
+        default:
+            return asynError;
+    }
+}
+
+/* Function lookup and dispatch of a read of every hardware parameter,
+ * through the old map of type erased tables and through the registry.
+ * Service name formatting is timed on its own by the names mode */
+static int benchDispatch (const char *endpoint, int verbose)
+{
+    std::unordered_map<int, benchFunctionsAny_t> timRxHwFunc;
+    std::unordered_map<int, benchFunctionsAny_t>::iterator func;
+    std::vector<int> functionIds;
+    epicsTimeStamp start, end;
+    const char *service = NULL;
+    double ops = 0.0;
+    double mapNs = 0.0;
+    double registryNs = 0.0;
+    volatile char sink = 0;
+    drvTimRx *pDrv = NULL;
+
+    pDrv = benchMicroPort(endpoint, verbose);
+    if (pDrv == NULL) {
+        return 1;
+    }
+
+    /* getHwFunc returns NULL past the last parameter */
+    for (int functionId = 0; functionId < BENCH_MAX_PARAMS; ++functionId) {
+        if (pDrv->getHwFunc(functionId) != NULL) {
+            functionIds.push_back(functionId);
+        }
+    }
+    ops = double(functionIds.size())*BENCH_MICRO_ROUNDS;
+
+    for (size_t i = 0; i < functionIds.size(); ++i) {
+        const functionsHw_t *hwFunc = pDrv->getHwFunc(functionIds[i]);
+
+        switch (hwFunc->type) {
+            case functionsHwInt32:
+                timRxHwFunc.emplace(functionIds[i], hwFunc->int32);
+                break;
+            case functionsHwInt32Chan:
+                timRxHwFunc.emplace(functionIds[i], hwFunc->int32Chan);
+                break;
+            case functionsHwFloat64:
+                timRxHwFunc.emplace(functionIds[i], hwFunc->float64);
+                break;
+            default:
+                break;
+        }
+    }
+
+    epicsTimeGetCurrent(&start);
+    for (int r = 0; r < BENCH_MICRO_ROUNDS; ++r) {
+        for (size_t i = 0; i < functionIds.size(); ++i) {
+            func = timRxHwFunc.find(functionIds[i]);
+            if (func == timRxHwFunc.end()) {
+                continue;
+            }
+            sink += func->second.getServiceName()[0];
+            func->second.executeHwRead();
+        }
+    }
+    epicsTimeGetCurrent(&end);
+    mapNs = benchNsPerOp(&start, &end, ops);
+
+    epicsTimeGetCurrent(&start);
+    for (int r = 0; r < BENCH_MICRO_ROUNDS; ++r) {
+        for (size_t i = 0; i < functionIds.size(); ++i) {
+            benchRegistryRead(pDrv, functionIds[i], &service);
+            sink += service[0];
+        }
+    }
+    epicsTimeGetCurrent(&end);
+    registryNs = benchNsPerOp(&start, &end, ops);
+
+    printf("dispatch: %u hardware parameters, %.0f reads each way\n",
+            (unsigned) functionIds.size(), ops);
+    printf("dispatch: unordered_map + any_cast %8.1f ns/op\n", mapNs);
+    printf("dispatch: registry                 %8.1f ns/op\n", registryNs);
+
+    return 0;
+}
+
+/* Serve the receivers of timRxList for duration seconds, with the pollers
+ * running, as an IOC with no clients would */
+static int benchServe (const char *endpoint, const char *timRxList,
+        int verbose, int numWorkers, double duration)
+{
+    if (drvTimRxConfigureCrate(BENCH_PORT_PREFIX, endpoint, timRxList, verbose,
+                DFLT_TIMEOUT, numWorkers) != asynSuccess) {
+        return 1;
+    }
+    epicsThreadSleep(duration);
+    return 0;
+}
+
+/* Run this program in serve mode for timRxList. Returns the child pid or
+ * -1 */
+static pid_t benchSpawnServe (const char *program, const char *endpoint,
+        const char *timRxList, int numWorkers, double duration)
+{
+    char workersStr[16];
+    char durationStr[32];
+    pid_t pid;
+
+    epicsSnprintf(workersStr, sizeof(workersStr), "%d", numWorkers);
+    epicsSnprintf(durationStr, sizeof(durationStr), "%f", duration);
+
+    pid = fork();
+    if (pid == 0) {
+        execlp(program, program, "-m", "serve", "-r", timRxList, "-b", endpoint,
+                "-w", workersStr, "-d", durationStr, (char *) NULL);
+        _exit(127);
+    }
+
+    return pid;
+}
+
+/* Wait for num children and add up their peak RSS, in kB, and CPU time,
+ * in seconds. Returns the number of children that failed */
+static int benchWaitServe (const pid_t *pids, int num, long *rssKb, double *cpu)
+{
+    struct rusage usage;
+    int failed = 0;
+    int status;
+
+    *rssKb = 0;
+    *cpu = 0.0;
+    for (int i = 0; i < num; ++i) {
+        if (pids[i] < 0 || wait4(pids[i], &status, 0, &usage) < 0 ||
+                !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            ++failed;
+            continue;
+        }
+        *rssKb += usage.ru_maxrss;
+        *cpu += usage.ru_utime.tv_sec + usage.ru_utime.tv_usec*1e-6 +
+            usage.ru_stime.tv_sec + usage.ru_stime.tv_usec*1e-6;
+    }
+
+    return failed;
+}
+
+/* One process for the whole crate against one process per receiver, both
+ * for duration seconds */
+static int benchCrate (const char *program, const char *endpoint,
+        int numWorkers, double duration)
+{
+    pid_t pids[BENCH_CRATE_SIZE];
+    char timRxList[16];
+    long rssKb = 0;
+    double cpu = 0.0;
+    int failed = 0;
+
+    pids[0] = benchSpawnServe(program, endpoint, BENCH_CRATE_LIST, numWorkers,
+            duration);
+    failed = benchWaitServe(pids, 1, &rssKb, &cpu);
+    if (failed > 0) {
+        fprintf(stderr, "TimRxMicroBench: crate process failed\n");
+        return 1;
+    }
+    printf("crate: 1 process, %d receivers: peak RSS %8ld kB, CPU %7.3f s "
+            "in %.1f s\n", BENCH_CRATE_SIZE, rssKb, cpu, duration);
+
+    for (int i = 0; i < BENCH_CRATE_SIZE; ++i) {
+        epicsSnprintf(timRxList, sizeof(timRxList), "%d", i + 1);
+        pids[i] = benchSpawnServe(program, endpoint, timRxList, numWorkers,
+                duration);
+    }
+    failed = benchWaitServe(pids, BENCH_CRATE_SIZE, &rssKb, &cpu);
+    if (failed > 0) {
+        fprintf(stderr, "TimRxMicroBench: %d receiver processes failed\n", failed);
+        return 1;
+    }
+    printf("crate: %d processes, 1 receiver each: peak RSS %8ld kB, CPU %7.3f s "
+            "in %.1f s\n", BENCH_CRATE_SIZE, rssKb, cpu, duration);
+
+    return 0;
+}
+
+/* Reference Si57x solution: every HS_DIV and every valid N1 are tried,
+ * with no bounds derived from the DCO limits. Same error and tie rules as
+ * Si57xSolver::solveUncached */
+static bool si57xBruteForce (uint32_t freq, si57xRegs_t *regs)
+{
+    static const uint32_t hsDivOpt[SI57X_NUM_HS_DIV] = {11, 9, 7, 6, 5, 4};
+    static const uint32_t hsDivVal[SI57X_NUM_HS_DIV] = {7, 5, 3, 2, 1, 0};
+    bool found = false;
+    uint64_t bestFdco = 0;
+    double bestAbsErr = 0.0;
+
+    for (unsigned i = 0; i < SI57X_NUM_HS_DIV; ++i) {
+        for (uint64_t n1 = 1; n1 <= SI57X_N1_MAX; n1 = (n1 == 1)? 2 : n1 + 2) {
+            uint64_t fdco = uint64_t(freq)*hsDivOpt[i]*n1;
+            uint64_t rfreq;
+            double err;
+            double absErr;
+
+            if (fdco < SI57X_FDCO_MIN || fdco > SI57X_FDCO_MAX) {
+                continue;
+            }
+
+            rfreq = ((fdco << SI57X_RFREQ_FRAC_BITS) + SI57X_FXTAL/2)/SI57X_FXTAL;
+            err = double(rfreq)*double(SI57X_FXTAL)/
+                double(1ULL << SI57X_RFREQ_FRAC_BITS)/double(hsDivOpt[i]*n1) -
+                double(freq);
+            absErr = (err < 0.0)? -err : err;
+            if (!found || absErr < bestAbsErr ||
+                    (absErr == bestAbsErr && fdco < bestFdco)) {
+                found = true;
+                bestFdco = fdco;
+                bestAbsErr = absErr;
+                regs->n1 = uint32_t(n1 - 1);
+                regs->hsDiv = hsDivVal[i];
+                regs->rfreqLo = uint32_t(rfreq & ((1ULL << SI57X_RFREQ_LO_BITS) - 1));
+                regs->rfreqHi = uint32_t(rfreq >> SI57X_RFREQ_LO_BITS);
+                regs->freqErr = err;
+            }
+        }
+    }
+
+    return found;
+}
+
+/* Compare the solver and the reference at freq. Returns 0 if they agree */
+static int si57xCheck (uint32_t freq, unsigned long *mismatches)
+{
+    si57xRegs_t regs, ref;
+    bool found, refFound;
+
+    memset(&regs, 0, sizeof(regs));
+    memset(&ref, 0, sizeof(ref));
+    found = Si57xSolver::solveUncached(freq, &regs);
+    refFound = si57xBruteForce(freq, &ref);
+    if (found == refFound && (!found ||
+                (regs.n1 == ref.n1 && regs.hsDiv == ref.hsDiv &&
+                 regs.rfreqLo == ref.rfreqLo && regs.rfreqHi == ref.rfreqHi))) {
+        return 0;
+    }
+
+    if ((*mismatches)++ < 10) {
+        printf("si57x: mismatch at %u Hz: solver %s n1 %u hs_div %u "
+                "rfreq 0x%05x%05x, brute force %s n1 %u hs_div %u rfreq 0x%05x%05x\n",
+                freq, found? "found" : "none", regs.n1, regs.hsDiv,
+                regs.rfreqHi, regs.rfreqLo, refFound? "found" : "none",
+                ref.n1, ref.hsDiv, ref.rfreqHi, ref.rfreqLo);
+    }
+    return -1;
+}
+
+/* Time fn over freqs, in ns per call */
+static double si57xTime (bool (*fn)(uint32_t, si57xRegs_t *),
+        const std::vector<uint32_t> &freqs)
+{
+    epicsTimeStamp start, end;
+    si57xRegs_t regs;
+    volatile uint32_t sink = 0;
+
+    epicsTimeGetCurrent(&start);
+    for (size_t i = 0; i < freqs.size(); ++i) {
+        fn(freqs[i], &regs);
+        sink += regs.rfreqLo;
+    }
+    epicsTimeGetCurrent(&end);
+
+    return freqs.empty()? 0.0 :
+        epicsTimeDiffInSeconds(&end, &start)*1e9/double(freqs.size());
+}
+
+/* Check Si57xSolver::solveUncached against si57xBruteForce over
+ * [SI57X_FOUT_MIN, SI57X_FOUT_MAX] every step Hz, at the frequencies
+ * where a DCO limit is crossed for some (HS_DIV, N1) and just outside the
+ * range, then time both */
+static int benchSi57x (uint32_t step)
+{
+    static const uint32_t hsDivOpt[SI57X_NUM_HS_DIV] = {11, 9, 7, 6, 5, 4};
+    const uint64_t limits[] = {SI57X_FDCO_MIN, SI57X_FDCO_MAX};
+    std::vector<uint32_t> freqs;
+    unsigned long mismatches = 0;
+    unsigned long checked = 0;
+    Si57xSolver solver;
+    epicsTimeStamp start, end;
+    si57xRegs_t regs;
+    volatile uint32_t sink = 0;
+    double cachedNs;
+
+    if (step == 0) {
+        step = uint32_t((SI57X_FOUT_MAX - SI57X_FOUT_MIN)/BENCH_SI57X_POINTS) + 1;
+    }
+
+    for (uint64_t freq = SI57X_FOUT_MIN; freq <= SI57X_FOUT_MAX; freq += step) {
+        si57xCheck(uint32_t(freq), &mismatches);
+        ++checked;
+        if (freqs.size() < BENCH_SI57X_POINTS) {
+            freqs.push_back(uint32_t(freq));
+        }
+    }
+
+    for (unsigned i = 0; i < SI57X_NUM_HS_DIV; ++i) {
+        for (uint64_t n1 = 1; n1 <= SI57X_N1_MAX; n1 = (n1 == 1)? 2 : n1 + 2) {
+            for (size_t l = 0; l < sizeof(limits)/sizeof(limits[0]); ++l) {
+                uint64_t edge = limits[l]/(hsDivOpt[i]*n1);
+                for (uint64_t freq = edge - 1; freq <= edge + 2; ++freq) {
+                    si57xCheck(uint32_t(freq), &mismatches);
+                    ++checked;
+                }
+            }
+        }
+    }
+    si57xCheck(uint32_t(SI57X_FOUT_MIN - 1), &mismatches);
+    si57xCheck(uint32_t(SI57X_FOUT_MAX + 1), &mismatches);
+    checked += 2;
+
+    printf("si57x: %lu frequencies checked, step %u Hz, %lu mismatches\n",
+            checked, step, mismatches);
+    printf("si57x: solveUncached %8.1f ns/op\n",
+            si57xTime(Si57xSolver::solveUncached, freqs));
+    printf("si57x: brute force   %8.1f ns/op\n",
+            si57xTime(si57xBruteForce, freqs));
+
+    /* Cache hits, as records writing one of a few frequencies */
+    solver.solve(125000000, &regs);
+    epicsTimeGetCurrent(&start);
+    for (size_t i = 0; i < freqs.size(); ++i) {
+        solver.solve(125000000, &regs);
+        sink += regs.rfreqLo;
+    }
+    epicsTimeGetCurrent(&end);
+    cachedNs = freqs.empty()? 0.0 :
+        epicsTimeDiffInSeconds(&end, &start)*1e9/double(freqs.size());
+    printf("si57x: solve, cached %8.1f ns/op\n", cachedNs);
+
+    return (mismatches > 0)? 1 : 0;
+}
+
+int main (int argc, char *argv [])
+{
+    int err = 0;
+    int verbose = 0;
+    const char *endpoint = DFLT_ENDPOINT;
+    const char *mode = NULL;
+    const char *timRxList = BENCH_CRATE_LIST;
+    double duration = DFLT_DURATION;
+    int numWorkers = DFLT_WORKERS;
+    uint32_t si57xStep = 0;
+    int i;
+
+    for (i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-v") == 0) {
+            verbose = 1;
+        }
+        else if (strcmp(argv[i], "-h") == 0) {
+            print_help (argv [0]);
+            return 0;
+        }
+        else if (i+1 >= argc) {
+            print_help (argv [0]);
+            return 1;
+        }
+        else if (strcmp(argv[i], "-m") == 0) {
+            mode = argv[++i];
+        }
+        else if (strcmp(argv[i], "-b") == 0) {
+            endpoint = argv[++i];
+        }
+        else if (strcmp(argv[i], "-d") == 0) {
+            duration = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-r") == 0) {
+            timRxList = argv[++i];
+        }
+        else if (strcmp(argv[i], "-w") == 0) {
+            numWorkers = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-s") == 0) {
+            si57xStep = (uint32_t)strtoul(argv[++i], NULL, 10);
+        }
+        else {
+            print_help (argv [0]);
+            return 1;
+        }
+    }
+
+    if (mode == NULL || duration <= 0.0 || numWorkers <= 0) {
+        print_help (argv [0]);
+        return 1;
+    }
+
+    if (strcmp(mode, "names") == 0) {
+        err = benchNames(endpoint, verbose);
+    }
+    else if (strcmp(mode, "dispatch") == 0) {
+        err = benchDispatch(endpoint, verbose);
+    }
+    else if (strcmp(mode, "crate") == 0) {
+        /* Only spawns and waits for other processes */
+        return benchCrate(argv[0], endpoint, numWorkers, duration);
+    }
+    else if (strcmp(mode, "serve") == 0) {
+        err = benchServe(endpoint, timRxList, verbose, numWorkers, duration);
+    }
+    else if (strcmp(mode, "si57x") == 0) {
+        /* Creates no port */
+        return benchSi57x(si57xStep);
+    }
+    else {
+        fprintf(stderr, "TimRxMicroBench: unknown mode %s\n", mode);
+        print_help (argv [0]);
+        return 1;
+    }
+
+    /* Runs the driver exit handlers, which stop its threads */
+    epicsExit(err);
+    return err;
+}
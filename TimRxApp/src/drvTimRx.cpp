@@ -11,6 +11,7 @@
 #include <stdio.h>
 #include <errno.h>
 #include <math.h>
+#include <cmath>
 
 #include <epicsTypes.h>
 #include <epicsTime.h>
@@ -19,7 +20,9 @@
 #include <epicsTimer.h>
 #include <epicsMutex.h>
 #include <epicsEvent.h>
+#include <epicsAtomic.h>
 #include <iocsh.h>
+#include <dbAccess.h>
 
 #include "drvTimRx.h"
 #include <epicsExport.h>
@@ -55,77 +58,647 @@ static const boardMap_t boardMap[MAX_TIM_RXS+1] = {
     /* 24           */ {12,  1}
 };
 
-/* Int32 functions mapping */
-static const functionsAny_t timRxSetGetLinkStatusFunc =               {functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_link_status, afc_timing_get_link_status}};
-static const functionsAny_t timRxSetGetRxenStatusFunc =               {functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_rxen_status, afc_timing_get_rxen_status}};
-static const functionsAny_t timRxSetGetRefClkLockedFunc =             {functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_ref_clk_locked, afc_timing_get_ref_clk_locked}};
-static const functionsAny_t timRxSetGetEvrenFunc =                    {functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_evren, afc_timing_get_evren}};
-static const functionsAny_t timRxSetGetAliveFunc =                    {functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_alive, afc_timing_get_alive}};
-
-static const functionsAny_t timRxSetGetAmcEnFunc =                    {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_amc_en, halcs_get_afc_timing_amc_en}};
-static const functionsAny_t timRxSetGetAmcPolFunc =                   {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_amc_pol, halcs_get_afc_timing_amc_pol}};
-static const functionsAny_t timRxSetGetAmcLogFunc =                   {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_amc_log, halcs_get_afc_timing_amc_log}};
-static const functionsAny_t timRxSetGetAmcItlFunc =                   {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_amc_itl, halcs_get_afc_timing_amc_itl}};
-static const functionsAny_t timRxSetGetAmcSrcFunc =                   {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_amc_src, halcs_get_afc_timing_amc_src}};
-static const functionsAny_t timRxSetGetAmcDirFunc =                   {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_amc_dir, halcs_get_afc_timing_amc_dir}};
-static const functionsAny_t timRxSetGetAmcCntRstFunc =                {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_amc_count_rst, halcs_get_afc_timing_amc_count_rst}};
-static const functionsAny_t timRxSetGetAmcPulsesFunc =                {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_amc_pulses, halcs_get_afc_timing_amc_pulses}};
-static const functionsAny_t timRxSetGetAmcCntFunc =                   {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_amc_count, halcs_get_afc_timing_amc_count}};
-static const functionsAny_t timRxSetGetAmcEvtFunc =                   {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_amc_evt, halcs_get_afc_timing_amc_evt}};
-static const functionsAny_t timRxSetGetAmcDlyFunc =                   {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_amc_dly, halcs_get_afc_timing_amc_dly}};
-static const functionsAny_t timRxSetGetAmcWdtFunc =                   {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_amc_wdt, halcs_get_afc_timing_amc_wdt}};
-
-static const functionsAny_t timRxSetGetFmc1EnFunc =                   {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc1_en, halcs_get_afc_timing_fmc1_en}};
-static const functionsAny_t timRxSetGetFmc1PolFunc =                  {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc1_pol, halcs_get_afc_timing_fmc1_pol}};
-static const functionsAny_t timRxSetGetFmc1LogFunc =                  {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc1_log, halcs_get_afc_timing_fmc1_log}};
-static const functionsAny_t timRxSetGetFmc1ItlFunc =                  {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc1_itl, halcs_get_afc_timing_fmc1_itl}};
-static const functionsAny_t timRxSetGetFmc1SrcFunc =                  {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc1_src, halcs_get_afc_timing_fmc1_src}};
-static const functionsAny_t timRxSetGetFmc1DirFunc =                  {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc1_dir, halcs_get_afc_timing_fmc1_dir}};
-static const functionsAny_t timRxSetGetFmc1CntRstFunc =               {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc1_count_rst, halcs_get_afc_timing_fmc1_count_rst}};
-static const functionsAny_t timRxSetGetFmc1PulsesFunc =               {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc1_pulses, halcs_get_afc_timing_fmc1_pulses}};
-static const functionsAny_t timRxSetGetFmc1CntFunc =                  {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc1_count, halcs_get_afc_timing_fmc1_count}};
-static const functionsAny_t timRxSetGetFmc1EvtFunc =                  {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc1_evt, halcs_get_afc_timing_fmc1_evt}};
-static const functionsAny_t timRxSetGetFmc1DlyFunc =                  {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc1_dly, halcs_get_afc_timing_fmc1_dly}};
-static const functionsAny_t timRxSetGetFmc1WdtFunc =                  {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc1_wdt, halcs_get_afc_timing_fmc1_wdt}};
-
-static const functionsAny_t timRxSetGetFmc2EnFunc =                   {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc2_en, halcs_get_afc_timing_fmc2_en}};
-static const functionsAny_t timRxSetGetFmc2PolFunc =                  {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc2_pol, halcs_get_afc_timing_fmc2_pol}};
-static const functionsAny_t timRxSetGetFmc2LogFunc =                  {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc2_log, halcs_get_afc_timing_fmc2_log}};
-static const functionsAny_t timRxSetGetFmc2ItlFunc =                  {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc2_itl, halcs_get_afc_timing_fmc2_itl}};
-static const functionsAny_t timRxSetGetFmc2SrcFunc =                  {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc2_src, halcs_get_afc_timing_fmc2_src}};
-static const functionsAny_t timRxSetGetFmc2DirFunc =                  {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc2_dir, halcs_get_afc_timing_fmc2_dir}};
-static const functionsAny_t timRxSetGetFmc2CntRstFunc =               {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc2_count_rst, halcs_get_afc_timing_fmc2_count_rst}};
-static const functionsAny_t timRxSetGetFmc2PulsesFunc =               {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc2_pulses, halcs_get_afc_timing_fmc2_pulses}};
-static const functionsAny_t timRxSetGetFmc2CntFunc =               {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc2_count, halcs_get_afc_timing_fmc2_count}};
-static const functionsAny_t timRxSetGetFmc2EvtFunc =                  {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc2_evt, halcs_get_afc_timing_fmc2_evt}};
-static const functionsAny_t timRxSetGetFmc2DlyFunc =                  {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc2_dly, halcs_get_afc_timing_fmc2_dly}};
-static const functionsAny_t timRxSetGetFmc2WdtFunc =                  {functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc2_wdt, halcs_get_afc_timing_fmc2_wdt}};
-
-static const functionsAny_t timRxSetGetRtmFreqKpFunc =                {functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_rtm_freq_kp, afc_timing_get_rtm_freq_kp}};
-static const functionsAny_t timRxSetGetRtmFreqKiFunc =                {functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_rtm_freq_ki, afc_timing_get_rtm_freq_ki}};
-static const functionsAny_t timRxSetGetRtmPhaseKpFunc =               {functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_rtm_phase_kp, afc_timing_get_rtm_phase_kp}};
-static const functionsAny_t timRxSetGetRtmPhaseKiFunc =               {functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_rtm_phase_ki, afc_timing_get_rtm_phase_ki}};
-static const functionsAny_t timRxSetGetRtmPhaseNavgFunc =             {functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_rtm_phase_navg, afc_timing_get_rtm_phase_navg}};
-static const functionsAny_t timRxSetGetRtmPhaseDivExpFunc =           {functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_rtm_phase_div_exp, afc_timing_get_rtm_phase_div_exp}};
-static const functionsAny_t timRxSetGetRtmRfreqHiFunc =               {functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_rtm_rfreq_hi, afc_timing_get_rtm_rfreq_hi}};
-static const functionsAny_t timRxSetGetRtmRfreqLoFunc =               {functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_rtm_rfreq_lo, afc_timing_get_rtm_rfreq_lo}};
-static const functionsAny_t timRxSetGetRtmN1Func =                    {functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_rtm_n1, afc_timing_get_rtm_n1}};
-static const functionsAny_t timRxSetGetRtmHsDivFunc =                 {functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_rtm_hs_div, afc_timing_get_rtm_hs_div}};
-
-static const functionsAny_t timRxSetGetAfcFreqKpFunc =                {functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_afc_freq_kp, afc_timing_get_afc_freq_kp}};
-static const functionsAny_t timRxSetGetAfcFreqKiFunc =                {functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_afc_freq_ki, afc_timing_get_afc_freq_ki}};
-static const functionsAny_t timRxSetGetAfcPhaseKpFunc =               {functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_afc_phase_kp, afc_timing_get_afc_phase_kp}};
-static const functionsAny_t timRxSetGetAfcPhaseKiFunc =               {functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_afc_phase_ki, afc_timing_get_afc_phase_ki}};
-static const functionsAny_t timRxSetGetAfcPhaseNavgFunc =             {functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_afc_phase_navg, afc_timing_get_afc_phase_navg}};
-static const functionsAny_t timRxSetGetAfcPhaseDivExpFunc =           {functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_afc_phase_div_exp, afc_timing_get_afc_phase_div_exp}};
-static const functionsAny_t timRxSetGetAfcRfreqHiFunc =               {functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_afc_rfreq_hi, afc_timing_get_afc_rfreq_hi}};
-static const functionsAny_t timRxSetGetAfcRfreqLoFunc =               {functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_afc_rfreq_lo, afc_timing_get_afc_rfreq_lo}};
-static const functionsAny_t timRxSetGetAfcN1Func =                    {functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_afc_n1, afc_timing_get_afc_n1}};
-static const functionsAny_t timRxSetGetAfcHsDivFunc =                 {functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_afc_hs_div, afc_timing_get_afc_hs_div}};
+/* Parameter registry. Entries must be in the same order as the parameter
+ * indexes declared in drvTimRx, as the hardware function for a parameter is
+ * found at timRxParams[functionId - FIRST_COMMAND]. Parameters without a
+ * hardware function are just written to the parameter library. The Si57x
+ * frequency entries only carry the service name, as they are handled by
+ * dedicated functions */
+const paramDesc_t drvTimRx::timRxParams[] = {
+    /* drvInfo string, type, index, number of addresses, hardware function,
+     * flags (optional) */
+    {P_TimRxLinkStatusString, asynParamUInt32Digital, &drvTimRx::P_TimRxLinkStatus, 1,
+        functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_link_status, afc_timing_get_link_status},
+        TIM_RX_PARAM_VOLATILE},
+    {P_TimRxRxenStatusString, asynParamUInt32Digital, &drvTimRx::P_TimRxRxenStatus, 1,
+        functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_rxen_status, afc_timing_get_rxen_status},
+        TIM_RX_PARAM_VOLATILE},
+    {P_TimRxRefClkLockedString, asynParamUInt32Digital, &drvTimRx::P_TimRxRefClkLocked, 1,
+        functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_ref_clk_locked, afc_timing_get_ref_clk_locked},
+        TIM_RX_PARAM_VOLATILE},
+    {P_TimRxEvrenString, asynParamUInt32Digital, &drvTimRx::P_TimRxEvren, 1,
+        functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_evren, afc_timing_get_evren}},
+    {P_TimRxAliveString, asynParamUInt32Digital, &drvTimRx::P_TimRxAlive, 1,
+        functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_alive, afc_timing_get_alive},
+        TIM_RX_PARAM_VOLATILE},
+
+    {P_TimRxAmcEnString, asynParamUInt32Digital, &drvTimRx::P_TimRxAmcEn, MAX_AMC_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_amc_en, halcs_get_afc_timing_amc_en}},
+    {P_TimRxAmcPolString, asynParamUInt32Digital, &drvTimRx::P_TimRxAmcPol, MAX_AMC_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_amc_pol, halcs_get_afc_timing_amc_pol}},
+    {P_TimRxAmcLogString, asynParamUInt32Digital, &drvTimRx::P_TimRxAmcLog, MAX_AMC_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_amc_log, halcs_get_afc_timing_amc_log}},
+    {P_TimRxAmcItlString, asynParamUInt32Digital, &drvTimRx::P_TimRxAmcItl, MAX_AMC_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_amc_itl, halcs_get_afc_timing_amc_itl}},
+    {P_TimRxAmcSrcString, asynParamUInt32Digital, &drvTimRx::P_TimRxAmcSrc, MAX_AMC_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_amc_src, halcs_get_afc_timing_amc_src}},
+    {P_TimRxAmcDirString, asynParamUInt32Digital, &drvTimRx::P_TimRxAmcDir, MAX_AMC_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_amc_dir, halcs_get_afc_timing_amc_dir}},
+    {P_TimRxAmcCntRstString, asynParamUInt32Digital, &drvTimRx::P_TimRxAmcCntRst, MAX_AMC_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_amc_count_rst, halcs_get_afc_timing_amc_count_rst},
+        TIM_RX_PARAM_VOLATILE | TIM_RX_PARAM_SIDE_EFFECT},
+    {P_TimRxAmcPulsesString, asynParamUInt32Digital, &drvTimRx::P_TimRxAmcPulses, MAX_AMC_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_amc_pulses, halcs_get_afc_timing_amc_pulses}},
+    {P_TimRxAmcCntString, asynParamUInt32Digital, &drvTimRx::P_TimRxAmcCnt, MAX_AMC_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_amc_count, halcs_get_afc_timing_amc_count},
+        TIM_RX_PARAM_VOLATILE},
+    {P_TimRxAmcEvtString, asynParamUInt32Digital, &drvTimRx::P_TimRxAmcEvt, MAX_AMC_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_amc_evt, halcs_get_afc_timing_amc_evt}},
+    {P_TimRxAmcDlyString, asynParamUInt32Digital, &drvTimRx::P_TimRxAmcDly, MAX_AMC_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_amc_dly, halcs_get_afc_timing_amc_dly},
+        TIM_RX_PARAM_COALESCE},
+    {P_TimRxAmcWdtString, asynParamUInt32Digital, &drvTimRx::P_TimRxAmcWdt, MAX_AMC_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_amc_wdt, halcs_get_afc_timing_amc_wdt},
+        TIM_RX_PARAM_COALESCE},
+
+    {P_TimRxFmc1EnString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc1En, MAX_FMC1_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc1_en, halcs_get_afc_timing_fmc1_en}},
+    {P_TimRxFmc1PolString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc1Pol, MAX_FMC1_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc1_pol, halcs_get_afc_timing_fmc1_pol}},
+    {P_TimRxFmc1LogString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc1Log, MAX_FMC1_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc1_log, halcs_get_afc_timing_fmc1_log}},
+    {P_TimRxFmc1ItlString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc1Itl, MAX_FMC1_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc1_itl, halcs_get_afc_timing_fmc1_itl}},
+    {P_TimRxFmc1SrcString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc1Src, MAX_FMC1_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc1_src, halcs_get_afc_timing_fmc1_src}},
+    {P_TimRxFmc1DirString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc1Dir, MAX_FMC1_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc1_dir, halcs_get_afc_timing_fmc1_dir}},
+    {P_TimRxFmc1CntRstString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc1CntRst, MAX_FMC1_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc1_count_rst, halcs_get_afc_timing_fmc1_count_rst},
+        TIM_RX_PARAM_VOLATILE | TIM_RX_PARAM_SIDE_EFFECT},
+    {P_TimRxFmc1PulsesString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc1Pulses, MAX_FMC1_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc1_pulses, halcs_get_afc_timing_fmc1_pulses}},
+    {P_TimRxFmc1CntString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc1Cnt, MAX_FMC1_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc1_count, halcs_get_afc_timing_fmc1_count},
+        TIM_RX_PARAM_VOLATILE},
+    {P_TimRxFmc1EvtString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc1Evt, MAX_FMC1_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc1_evt, halcs_get_afc_timing_fmc1_evt}},
+    {P_TimRxFmc1DlyString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc1Dly, MAX_FMC1_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc1_dly, halcs_get_afc_timing_fmc1_dly},
+        TIM_RX_PARAM_COALESCE},
+    {P_TimRxFmc1WdtString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc1Wdt, MAX_FMC1_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc1_wdt, halcs_get_afc_timing_fmc1_wdt},
+        TIM_RX_PARAM_COALESCE},
+
+    {P_TimRxFmc2EnString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc2En, MAX_FMC2_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc2_en, halcs_get_afc_timing_fmc2_en}},
+    {P_TimRxFmc2PolString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc2Pol, MAX_FMC2_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc2_pol, halcs_get_afc_timing_fmc2_pol}},
+    {P_TimRxFmc2LogString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc2Log, MAX_FMC2_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc2_log, halcs_get_afc_timing_fmc2_log}},
+    {P_TimRxFmc2ItlString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc2Itl, MAX_FMC2_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc2_itl, halcs_get_afc_timing_fmc2_itl}},
+    {P_TimRxFmc2SrcString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc2Src, MAX_FMC2_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc2_src, halcs_get_afc_timing_fmc2_src}},
+    {P_TimRxFmc2DirString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc2Dir, MAX_FMC2_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc2_dir, halcs_get_afc_timing_fmc2_dir}},
+    {P_TimRxFmc2CntRstString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc2CntRst, MAX_FMC2_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc2_count_rst, halcs_get_afc_timing_fmc2_count_rst},
+        TIM_RX_PARAM_VOLATILE | TIM_RX_PARAM_SIDE_EFFECT},
+    {P_TimRxFmc2PulsesString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc2Pulses, MAX_FMC2_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc2_pulses, halcs_get_afc_timing_fmc2_pulses}},
+    {P_TimRxFmc2CntString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc2Cnt, MAX_FMC2_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc2_count, halcs_get_afc_timing_fmc2_count},
+        TIM_RX_PARAM_VOLATILE},
+    {P_TimRxFmc2EvtString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc2Evt, MAX_FMC2_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc2_evt, halcs_get_afc_timing_fmc2_evt}},
+    {P_TimRxFmc2DlyString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc2Dly, MAX_FMC2_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc2_dly, halcs_get_afc_timing_fmc2_dly},
+        TIM_RX_PARAM_COALESCE},
+    {P_TimRxFmc2WdtString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc2Wdt, MAX_FMC2_TRIGGER_CH,
+        functionsInt32Chan_t{"LNLS_AFC_TIMING", halcs_set_afc_timing_fmc2_wdt, halcs_get_afc_timing_fmc2_wdt},
+        TIM_RX_PARAM_COALESCE},
+
+    {P_TimRxRtmFreqKpString, asynParamUInt32Digital, &drvTimRx::P_TimRxRtmFreqKp, 1,
+        functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_rtm_freq_kp, afc_timing_get_rtm_freq_kp}},
+    {P_TimRxRtmFreqKiString, asynParamUInt32Digital, &drvTimRx::P_TimRxRtmFreqKi, 1,
+        functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_rtm_freq_ki, afc_timing_get_rtm_freq_ki}},
+    {P_TimRxRtmPhaseKpString, asynParamUInt32Digital, &drvTimRx::P_TimRxRtmPhaseKp, 1,
+        functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_rtm_phase_kp, afc_timing_get_rtm_phase_kp}},
+    {P_TimRxRtmPhaseKiString, asynParamUInt32Digital, &drvTimRx::P_TimRxRtmPhaseKi, 1,
+        functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_rtm_phase_ki, afc_timing_get_rtm_phase_ki}},
+    {P_TimRxRtmPhaseNavgString, asynParamUInt32Digital, &drvTimRx::P_TimRxRtmPhaseNavg, 1,
+        functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_rtm_phase_navg, afc_timing_get_rtm_phase_navg}},
+    {P_TimRxRtmPhaseDivExpString, asynParamUInt32Digital, &drvTimRx::P_TimRxRtmPhaseDivExp, 1,
+        functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_rtm_phase_div_exp, afc_timing_get_rtm_phase_div_exp}},
+    {P_TimRxRtmRfreqHiString, asynParamUInt32Digital, &drvTimRx::P_TimRxRtmRfreqHi, 1,
+        functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_rtm_rfreq_hi, afc_timing_get_rtm_rfreq_hi}},
+    {P_TimRxRtmRfreqLoString, asynParamUInt32Digital, &drvTimRx::P_TimRxRtmRfreqLo, 1,
+        functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_rtm_rfreq_lo, afc_timing_get_rtm_rfreq_lo}},
+    {P_TimRxRtmN1String, asynParamUInt32Digital, &drvTimRx::P_TimRxRtmN1, 1,
+        functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_rtm_n1, afc_timing_get_rtm_n1}},
+    {P_TimRxRtmHsDivString, asynParamUInt32Digital, &drvTimRx::P_TimRxRtmHsDiv, 1,
+        functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_rtm_hs_div, afc_timing_get_rtm_hs_div}},
+    {P_TimRxRtmSi57xFreqString, asynParamUInt32Digital, &drvTimRx::P_TimRxRtmSi57xFreq, 1,
+        functionsInt32_t{"LNLS_AFC_TIMING", NULL, NULL}},
+
+    {P_TimRxAfcFreqKpString, asynParamUInt32Digital, &drvTimRx::P_TimRxAfcFreqKp, 1,
+        functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_afc_freq_kp, afc_timing_get_afc_freq_kp}},
+    {P_TimRxAfcFreqKiString, asynParamUInt32Digital, &drvTimRx::P_TimRxAfcFreqKi, 1,
+        functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_afc_freq_ki, afc_timing_get_afc_freq_ki}},
+    {P_TimRxAfcPhaseKpString, asynParamUInt32Digital, &drvTimRx::P_TimRxAfcPhaseKp, 1,
+        functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_afc_phase_kp, afc_timing_get_afc_phase_kp}},
+    {P_TimRxAfcPhaseKiString, asynParamUInt32Digital, &drvTimRx::P_TimRxAfcPhaseKi, 1,
+        functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_afc_phase_ki, afc_timing_get_afc_phase_ki}},
+    {P_TimRxAfcPhaseNavgString, asynParamUInt32Digital, &drvTimRx::P_TimRxAfcPhaseNavg, 1,
+        functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_afc_phase_navg, afc_timing_get_afc_phase_navg}},
+    {P_TimRxAfcPhaseDivExpString, asynParamUInt32Digital, &drvTimRx::P_TimRxAfcPhaseDivExp, 1,
+        functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_afc_phase_div_exp, afc_timing_get_afc_phase_div_exp}},
+    {P_TimRxAfcRfreqHiString, asynParamUInt32Digital, &drvTimRx::P_TimRxAfcRfreqHi, 1,
+        functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_afc_rfreq_hi, afc_timing_get_afc_rfreq_hi}},
+    {P_TimRxAfcRfreqLoString, asynParamUInt32Digital, &drvTimRx::P_TimRxAfcRfreqLo, 1,
+        functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_afc_rfreq_lo, afc_timing_get_afc_rfreq_lo}},
+    {P_TimRxAfcN1String, asynParamUInt32Digital, &drvTimRx::P_TimRxAfcN1, 1,
+        functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_afc_n1, afc_timing_get_afc_n1}},
+    {P_TimRxAfcHsDivString, asynParamUInt32Digital, &drvTimRx::P_TimRxAfcHsDiv, 1,
+        functionsInt32_t{"LNLS_AFC_TIMING", afc_timing_set_afc_hs_div, afc_timing_get_afc_hs_div}},
+    {P_TimRxAfcSi57xFreqString, asynParamUInt32Digital, &drvTimRx::P_TimRxAfcSi57xFreq, 1,
+        functionsInt32_t{"LNLS_AFC_TIMING", NULL, NULL}},
+
+    {P_TimRxStatusPollPeriodString, asynParamFloat64, &drvTimRx::P_TimRxStatusPollPeriod, 1,
+        functionsHw_t()},
+    {P_TimRxStatusPollTimeString, asynParamFloat64, &drvTimRx::P_TimRxStatusPollTime, 1,
+        functionsHw_t()},
+    {P_TimRxCntPollPeriodString, asynParamFloat64, &drvTimRx::P_TimRxCntPollPeriod, 1,
+        functionsHw_t()},
+    {P_TimRxCntPollTimeString, asynParamFloat64, &drvTimRx::P_TimRxCntPollTime, 1,
+        functionsHw_t()},
+    {P_TimRxCntPollSkippedString, asynParamUInt32Digital, &drvTimRx::P_TimRxCntPollSkipped, 1,
+        functionsHw_t()},
+    {P_TimRxWriteHoldoffString, asynParamFloat64, &drvTimRx::P_TimRxWriteHoldoff, 1,
+        functionsHw_t()},
+    {P_TimRxWriteCoalescedString, asynParamUInt32Digital, &drvTimRx::P_TimRxWriteCoalesced, 1,
+        functionsHw_t()},
+    {P_TimRxWriteFlushLatencyString, asynParamFloat64, &drvTimRx::P_TimRxWriteFlushLatency, 1,
+        functionsHw_t()},
+    {P_TimRxWriteFlushLatencyMaxString, asynParamFloat64, &drvTimRx::P_TimRxWriteFlushLatencyMax, 1,
+        functionsHw_t()},
+    {P_TimRxWriteFlushLatencyAvgString, asynParamFloat64, &drvTimRx::P_TimRxWriteFlushLatencyAvg, 1,
+        functionsHw_t()},
+    {P_TimRxSi57xPollPeriodString, asynParamFloat64, &drvTimRx::P_TimRxSi57xPollPeriod, 1,
+        functionsHw_t()},
+    {P_TimRxRtmSi57xAgeString, asynParamFloat64, &drvTimRx::P_TimRxRtmSi57xAge, 1,
+        functionsHw_t()},
+    {P_TimRxAfcSi57xAgeString, asynParamFloat64, &drvTimRx::P_TimRxAfcSi57xAge, 1,
+        functionsHw_t()},
+    {P_TimRxRtmSi57xFreqErrString, asynParamFloat64, &drvTimRx::P_TimRxRtmSi57xFreqErr, 1,
+        functionsHw_t()},
+    {P_TimRxAfcSi57xFreqErrString, asynParamFloat64, &drvTimRx::P_TimRxAfcSi57xFreqErr, 1,
+        functionsHw_t()},
+    {P_TimRxShadowTtlString, asynParamFloat64, &drvTimRx::P_TimRxShadowTtl, 1,
+        functionsHw_t()},
+    {P_TimRxShadowHitsString, asynParamUInt32Digital, &drvTimRx::P_TimRxShadowHits, 1,
+        functionsHw_t()},
+    {P_TimRxShadowMissesString, asynParamUInt32Digital, &drvTimRx::P_TimRxShadowMisses, 1,
+        functionsHw_t()},
+    {P_TimRxWriteElideString, asynParamUInt32Digital, &drvTimRx::P_TimRxWriteElide, 1,
+        functionsHw_t()},
+    {P_TimRxWriteElidedString, asynParamUInt32Digital, &drvTimRx::P_TimRxWriteElided, 1,
+        functionsHw_t()},
+    {P_TimRxWriteElideAgeString, asynParamFloat64, &drvTimRx::P_TimRxWriteElideAge, 1,
+        functionsHw_t()},
+    {P_TimRxStartupTimeString, asynParamFloat64, &drvTimRx::P_TimRxStartupTime, 1,
+        functionsHw_t()},
+    {P_TimRxBreakerThresholdString, asynParamUInt32Digital, &drvTimRx::P_TimRxBreakerThreshold, 1,
+        functionsHw_t()},
+    {P_TimRxBreakerStateString, asynParamUInt32Digital, &drvTimRx::P_TimRxBreakerState, 1,
+        functionsHw_t()},
+    {P_TimRxBreakerTripsString, asynParamUInt32Digital, &drvTimRx::P_TimRxBreakerTrips, 1,
+        functionsHw_t()},
+    {P_TimRxBreakerOpenTimeString, asynParamFloat64, &drvTimRx::P_TimRxBreakerOpenTime, 1,
+        functionsHw_t()},
+    {P_TimRxPortLaneWaitHistString, asynParamInt32Array, &drvTimRx::P_TimRxPortLaneWaitHist, 1,
+        functionsHw_t()},
+    {P_TimRxPortLaneDepthHistString, asynParamInt32Array, &drvTimRx::P_TimRxPortLaneDepthHist, 1,
+        functionsHw_t()},
+    {P_TimRxPollLaneWaitHistString, asynParamInt32Array, &drvTimRx::P_TimRxPollLaneWaitHist, 1,
+        functionsHw_t()},
+    {P_TimRxPollLaneDepthHistString, asynParamInt32Array, &drvTimRx::P_TimRxPollLaneDepthHist, 1,
+        functionsHw_t()},
+    {P_TimRxAmcRateString, asynParamFloat64, &drvTimRx::P_TimRxAmcRate, MAX_AMC_TRIGGER_CH,
+        functionsHw_t()},
+    {P_TimRxAmcRateWindowString, asynParamFloat64, &drvTimRx::P_TimRxAmcRateWindow, MAX_AMC_TRIGGER_CH,
+        functionsHw_t()},
+    {P_TimRxFmc1RateString, asynParamFloat64, &drvTimRx::P_TimRxFmc1Rate, MAX_FMC1_TRIGGER_CH,
+        functionsHw_t()},
+    {P_TimRxFmc1RateWindowString, asynParamFloat64, &drvTimRx::P_TimRxFmc1RateWindow, MAX_FMC1_TRIGGER_CH,
+        functionsHw_t()},
+    {P_TimRxFmc2RateString, asynParamFloat64, &drvTimRx::P_TimRxFmc2Rate, MAX_FMC2_TRIGGER_CH,
+        functionsHw_t()},
+    {P_TimRxFmc2RateWindowString, asynParamFloat64, &drvTimRx::P_TimRxFmc2RateWindow, MAX_FMC2_TRIGGER_CH,
+        functionsHw_t()},
+    {P_TimRxAmcCntTotalString, asynParamInt64, &drvTimRx::P_TimRxAmcCntTotal, MAX_AMC_TRIGGER_CH,
+        functionsHw_t()},
+    {P_TimRxFmc1CntTotalString, asynParamInt64, &drvTimRx::P_TimRxFmc1CntTotal, MAX_FMC1_TRIGGER_CH,
+        functionsHw_t()},
+    {P_TimRxFmc2CntTotalString, asynParamInt64, &drvTimRx::P_TimRxFmc2CntTotal, MAX_FMC2_TRIGGER_CH,
+        functionsHw_t()},
+    {P_TimRxFpgaClkString, asynParamFloat64, &drvTimRx::P_TimRxFpgaClk, 1,
+        functionsHw_t()},
+    {P_TimRxAmcDelayString, asynParamFloat64, &drvTimRx::P_TimRxAmcDelay, MAX_AMC_TRIGGER_CH,
+        functionsHw_t()},
+    {P_TimRxAmcWidthString, asynParamFloat64, &drvTimRx::P_TimRxAmcWidth, MAX_AMC_TRIGGER_CH,
+        functionsHw_t()},
+    {P_TimRxFmc1DelayString, asynParamFloat64, &drvTimRx::P_TimRxFmc1Delay, MAX_FMC1_TRIGGER_CH,
+        functionsHw_t()},
+    {P_TimRxFmc1WidthString, asynParamFloat64, &drvTimRx::P_TimRxFmc1Width, MAX_FMC1_TRIGGER_CH,
+        functionsHw_t()},
+    {P_TimRxFmc2DelayString, asynParamFloat64, &drvTimRx::P_TimRxFmc2Delay, MAX_FMC2_TRIGGER_CH,
+        functionsHw_t()},
+    {P_TimRxFmc2WidthString, asynParamFloat64, &drvTimRx::P_TimRxFmc2Width, MAX_FMC2_TRIGGER_CH,
+        functionsHw_t()},
+    {P_TimRxAmcEnMaskString, asynParamUInt32Digital, &drvTimRx::P_TimRxAmcEnMask, 1,
+        functionsHw_t()},
+    {P_TimRxAmcPolMaskString, asynParamUInt32Digital, &drvTimRx::P_TimRxAmcPolMask, 1,
+        functionsHw_t()},
+    {P_TimRxAmcLogMaskString, asynParamUInt32Digital, &drvTimRx::P_TimRxAmcLogMask, 1,
+        functionsHw_t()},
+    {P_TimRxAmcItlMaskString, asynParamUInt32Digital, &drvTimRx::P_TimRxAmcItlMask, 1,
+        functionsHw_t()},
+    {P_TimRxAmcDirMaskString, asynParamUInt32Digital, &drvTimRx::P_TimRxAmcDirMask, 1,
+        functionsHw_t()},
+    {P_TimRxFmc1EnMaskString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc1EnMask, 1,
+        functionsHw_t()},
+    {P_TimRxFmc1PolMaskString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc1PolMask, 1,
+        functionsHw_t()},
+    {P_TimRxFmc1LogMaskString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc1LogMask, 1,
+        functionsHw_t()},
+    {P_TimRxFmc1ItlMaskString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc1ItlMask, 1,
+        functionsHw_t()},
+    {P_TimRxFmc1DirMaskString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc1DirMask, 1,
+        functionsHw_t()},
+    {P_TimRxFmc2EnMaskString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc2EnMask, 1,
+        functionsHw_t()},
+    {P_TimRxFmc2PolMaskString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc2PolMask, 1,
+        functionsHw_t()},
+    {P_TimRxFmc2LogMaskString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc2LogMask, 1,
+        functionsHw_t()},
+    {P_TimRxFmc2ItlMaskString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc2ItlMask, 1,
+        functionsHw_t()},
+    {P_TimRxFmc2DirMaskString, asynParamUInt32Digital, &drvTimRx::P_TimRxFmc2DirMask, 1,
+        functionsHw_t()},
+    {P_TimRxHwUnlockString, asynParamUInt32Digital, &drvTimRx::P_TimRxHwUnlock, 1,
+        functionsHw_t()},
+    {P_TimRxLockHoldMaxString, asynParamFloat64, &drvTimRx::P_TimRxLockHoldMax, 1,
+        functionsHw_t()},
+    {P_TimRxLockHoldAvgString, asynParamFloat64, &drvTimRx::P_TimRxLockHoldAvg, 1,
+        functionsHw_t()},
+    {P_TimRxNumWorkersString, asynParamUInt32Digital, &drvTimRx::P_TimRxNumWorkers, 1,
+        functionsHw_t()},
+    {P_TimRxTraceDumpString, asynParamUInt32Digital, &drvTimRx::P_TimRxTraceDump, 1,
+        functionsHw_t()},
+    {P_TimRxTraceBufString, asynParamInt32Array, &drvTimRx::P_TimRxTraceBuf, 1,
+        functionsHw_t()},
+    {P_TimRxReadLatHistString, asynParamInt32Array, &drvTimRx::P_TimRxReadLatHist, 1,
+        functionsHw_t()},
+    {P_TimRxReadLatP50String, asynParamFloat64, &drvTimRx::P_TimRxReadLatP50, 1,
+        functionsHw_t()},
+    {P_TimRxReadLatP99String, asynParamFloat64, &drvTimRx::P_TimRxReadLatP99, 1,
+        functionsHw_t()},
+    {P_TimRxReadLatMaxString, asynParamFloat64, &drvTimRx::P_TimRxReadLatMax, 1,
+        functionsHw_t()},
+    {P_TimRxReadLatErrorsString, asynParamUInt32Digital, &drvTimRx::P_TimRxReadLatErrors, 1,
+        functionsHw_t()},
+    {P_TimRxReadLatTimeoutsString, asynParamUInt32Digital, &drvTimRx::P_TimRxReadLatTimeouts, 1,
+        functionsHw_t()},
+    {P_TimRxWriteLatHistString, asynParamInt32Array, &drvTimRx::P_TimRxWriteLatHist, 1,
+        functionsHw_t()},
+    {P_TimRxWriteLatP50String, asynParamFloat64, &drvTimRx::P_TimRxWriteLatP50, 1,
+        functionsHw_t()},
+    {P_TimRxWriteLatP99String, asynParamFloat64, &drvTimRx::P_TimRxWriteLatP99, 1,
+        functionsHw_t()},
+    {P_TimRxWriteLatMaxString, asynParamFloat64, &drvTimRx::P_TimRxWriteLatMax, 1,
+        functionsHw_t()},
+    {P_TimRxWriteLatErrorsString, asynParamUInt32Digital, &drvTimRx::P_TimRxWriteLatErrors, 1,
+        functionsHw_t()},
+    {P_TimRxWriteLatTimeoutsString, asynParamUInt32Digital, &drvTimRx::P_TimRxWriteLatTimeouts, 1,
+        functionsHw_t()},
+    {P_TimRxSi57xLatHistString, asynParamInt32Array, &drvTimRx::P_TimRxSi57xLatHist, 1,
+        functionsHw_t()},
+    {P_TimRxSi57xLatP50String, asynParamFloat64, &drvTimRx::P_TimRxSi57xLatP50, 1,
+        functionsHw_t()},
+    {P_TimRxSi57xLatP99String, asynParamFloat64, &drvTimRx::P_TimRxSi57xLatP99, 1,
+        functionsHw_t()},
+    {P_TimRxSi57xLatMaxString, asynParamFloat64, &drvTimRx::P_TimRxSi57xLatMax, 1,
+        functionsHw_t()},
+    {P_TimRxSi57xLatErrorsString, asynParamUInt32Digital, &drvTimRx::P_TimRxSi57xLatErrors, 1,
+        functionsHw_t()},
+    {P_TimRxSi57xLatTimeoutsString, asynParamUInt32Digital, &drvTimRx::P_TimRxSi57xLatTimeouts, 1,
+        functionsHw_t()},
+    {P_TimRxLatResetString, asynParamUInt32Digital, &drvTimRx::P_TimRxLatReset, 1,
+        functionsHw_t()},
+};
+
+const size_t drvTimRx::timRxNumParams = ARRAY_SIZE(drvTimRx::timRxParams);
 
 static const char *driverName="drvTimRx";
 void acqTask(void *drvPvt);
 
+/* HALCS clients shared by the receivers served by this IOC, one per
+ * (endpoint, board) */
+static std::vector<timRxSharedClient_t *> timRxSharedClients;
+static epicsMutexId timRxSharedClientsLock = NULL;
+
+/* Write worker running on the current thread, if any */
+static epicsThreadPrivateId timRxWorkerPvt = NULL;
+/* Event the current thread waits on for its register turns, created on
+ * first use */
+static epicsThreadPrivateId timRxTurnEventPvt = NULL;
+
+/* Poll scheduler shared by the receivers served by this IOC. The scheduler
+ * does not hold timRxPollLock while it calls into a driver, so that a slow
+ * sweep of one receiver does not stall registration of the others.
+ * Instead it marks the driver it is calling in timRxPollCurrent, and
+ * stopPollTask waits on timRxPollDoneEvent until that mark is gone, so a
+ * driver is never polled after it has been removed from timRxPollDrivers */
+static std::vector<drvTimRx *> timRxPollDrivers;
+static drvTimRx *timRxPollCurrent = NULL;
+static epicsMutexId timRxPollLock = NULL;
+static epicsEventId timRxPollEvent = NULL;
+static epicsEventId timRxPollDoneEvent = NULL;
+static bool timRxPollThreadStarted = false;
+
+static epicsThreadOnceId timRxOnceId = EPICS_THREAD_ONCE_INIT;
+
+static void timRxOnceC(void *arg)
+{
+    timRxSharedClientsLock = epicsMutexMustCreate();
+    timRxWorkerPvt = epicsThreadPrivateCreate();
+    timRxTurnEventPvt = epicsThreadPrivateCreate();
+    timRxPollLock = epicsMutexMustCreate();
+    timRxPollEvent = epicsEventMustCreate(epicsEventEmpty);
+    timRxPollDoneEvent = epicsEventMustCreate(epicsEventEmpty);
+}
+
+/* Add worker lane clients to sharedClient until it has numWorkers of them.
+ * Called with timRxSharedClientsLock held. The count is published once
+ * the new clients exist, so drivers already using the client only see
+ * complete lanes */
+static int timRxSharedClientGrow(timRxSharedClient_t *sharedClient,
+        int verbose, int timeout, int numWorkers)
+{
+    const char *timRxLogFile = "stdout";
+    int i = sharedClient->numWorkers;
+
+    if (numWorkers <= 1 || numWorkers <= sharedClient->numWorkers) {
+        return 0;
+    }
+
+    for (; i < numWorkers; ++i) {
+        sharedClient->workerClients[i] = halcs_client_new_time (sharedClient->endpoint,
+                verbose, timRxLogFile, timeout);
+        if (sharedClient->workerClients[i] == NULL) {
+            goto create_halcs_worker_client_err;
+        }
+        sharedClient->workerLocks[i] = epicsMutexMustCreate();
+    }
+    epicsAtomicSetIntT(&sharedClient->numWorkers, numWorkers);
+
+    return 0;
+
+create_halcs_worker_client_err:
+    while (--i >= sharedClient->numWorkers) {
+        epicsMutexDestroy(sharedClient->workerLocks[i]);
+        halcs_client_destroy (&sharedClient->workerClients[i]);
+    }
+    return -1;
+}
+
+/* Get the client for the given endpoint and board, creating it on first use.
+ * Verbosity and timeout are the ones of the first receiver of the board.
+ * The worker lanes grow to the largest number of workers asked for */
+static timRxSharedClient_t *timRxSharedClientAcquire(const char *endpoint, int board,
+        int verbose, int timeout, int numWorkers)
+{
+    timRxSharedClient_t *sharedClient = NULL;
+    const char *timRxLogFile = "stdout";
+
+    epicsThreadOnce(&timRxOnceId, timRxOnceC, NULL);
+
+    epicsMutexMustLock(timRxSharedClientsLock);
+    for (size_t i = 0; i < timRxSharedClients.size(); ++i) {
+        if (timRxSharedClients[i]->board == board &&
+                strcmp(timRxSharedClients[i]->endpoint, endpoint) == 0) {
+            sharedClient = timRxSharedClients[i];
+            if (timRxSharedClientGrow(sharedClient, verbose, timeout, numWorkers) != 0) {
+                goto grow_shared_client_err;
+            }
+            ++sharedClient->refCount;
+            goto shared_client_found;
+        }
+    }
+
+    sharedClient = (timRxSharedClient_t *) calloc(1, sizeof(*sharedClient));
+    if (sharedClient == NULL) {
+        goto alloc_shared_client_err;
+    }
+
+    sharedClient->endpoint = epicsStrDup(endpoint);
+    sharedClient->board = board;
+    sharedClient->refCount = 1;
+    sharedClient->lock = epicsMutexMustCreate();
+    sharedClient->pollLock = epicsMutexMustCreate();
+    sharedClient->client = halcs_client_new_time (sharedClient->endpoint, verbose,
+            timRxLogFile, timeout);
+    if (sharedClient->client == NULL) {
+        goto create_halcs_client_err;
+    }
+
+    sharedClient->pollClient = halcs_client_new_time (sharedClient->endpoint, verbose,
+            timRxLogFile, timeout);
+    if (sharedClient->pollClient == NULL) {
+        goto create_halcs_poll_client_err;
+    }
+
+    if (timRxSharedClientGrow(sharedClient, verbose, timeout, numWorkers) != 0) {
+        goto create_halcs_worker_client_err;
+    }
+
+    timRxSharedClients.push_back(sharedClient);
+
+shared_client_found:
+    epicsMutexUnlock(timRxSharedClientsLock);
+    return sharedClient;
+
+create_halcs_worker_client_err:
+    halcs_client_destroy (&sharedClient->pollClient);
+create_halcs_poll_client_err:
+    halcs_client_destroy (&sharedClient->client);
+create_halcs_client_err:
+    epicsMutexDestroy(sharedClient->pollLock);
+    epicsMutexDestroy(sharedClient->lock);
+    free(sharedClient->endpoint);
+    free(sharedClient);
+alloc_shared_client_err:
+grow_shared_client_err:
+    epicsMutexUnlock(timRxSharedClientsLock);
+    return NULL;
+}
+
+/* Take one more reference to a client already held */
+static void timRxSharedClientRef(timRxSharedClient_t *sharedClient)
+{
+    epicsMutexMustLock(timRxSharedClientsLock);
+    ++sharedClient->refCount;
+    epicsMutexUnlock(timRxSharedClientsLock);
+}
+
+/* Mark a client as broken, after a receiver lost its board through it.
+ * Receivers still holding it keep a valid, if failing, client until they
+ * release it */
+static void timRxSharedClientBreak(timRxSharedClient_t *sharedClient)
+{
+    epicsMutexMustLock(timRxSharedClientsLock);
+    if (!sharedClient->broken) {
+        for (size_t i = 0; i < timRxSharedClients.size(); ++i) {
+            if (timRxSharedClients[i] == sharedClient) {
+                timRxSharedClients.erase(timRxSharedClients.begin() + i);
+                break;
+            }
+        }
+        epicsAtomicSetIntT(&sharedClient->broken, 1);
+    }
+    epicsMutexUnlock(timRxSharedClientsLock);
+}
+
+static int timRxSharedClientIsBroken(timRxSharedClient_t *sharedClient)
+{
+    return epicsAtomicGetIntT(&sharedClient->broken);
+}
+
+static void timRxSharedClientRelease(timRxSharedClient_t *sharedClient)
+{
+    epicsMutexMustLock(timRxSharedClientsLock);
+    if (--sharedClient->refCount > 0) {
+        epicsMutexUnlock(timRxSharedClientsLock);
+        return;
+    }
+
+    for (size_t i = 0; i < timRxSharedClients.size(); ++i) {
+        if (timRxSharedClients[i] == sharedClient) {
+            timRxSharedClients.erase(timRxSharedClients.begin() + i);
+            break;
+        }
+    }
+    epicsMutexUnlock(timRxSharedClientsLock);
+
+    /* Wait for any call still in flight */
+    epicsMutexMustLock(sharedClient->lock);
+    halcs_client_destroy (&sharedClient->client);
+    epicsMutexUnlock(sharedClient->lock);
+    epicsMutexMustLock(sharedClient->pollLock);
+    halcs_client_destroy (&sharedClient->pollClient);
+    epicsMutexUnlock(sharedClient->pollLock);
+    for (int i = 0; i < sharedClient->numWorkers; ++i) {
+        epicsMutexMustLock(sharedClient->workerLocks[i]);
+        halcs_client_destroy (&sharedClient->workerClients[i]);
+        epicsMutexUnlock(sharedClient->workerLocks[i]);
+        epicsMutexDestroy(sharedClient->workerLocks[i]);
+    }
+
+    epicsMutexDestroy(sharedClient->pollLock);
+    epicsMutexDestroy(sharedClient->lock);
+    free(sharedClient->endpoint);
+    free(sharedClient);
+}
+
+/* Mark drv as being called by the poll scheduler. Returns false if it
+ * has been removed from timRxPollDrivers since the scheduler copied it */
+static bool pollSchedulerClaim(drvTimRx *drv)
+{
+    bool registered = false;
+
+    epicsMutexMustLock(timRxPollLock);
+    for (size_t i = 0; i < timRxPollDrivers.size(); ++i) {
+        if (timRxPollDrivers[i] == drv) {
+            registered = true;
+            timRxPollCurrent = drv;
+            break;
+        }
+    }
+    epicsMutexUnlock(timRxPollLock);
+
+    return registered;
+}
+
+/* Clear the mark of pollSchedulerClaim and wake up a stopPollTask waiting
+ * for it */
+static void pollSchedulerRelease()
+{
+    epicsMutexMustLock(timRxPollLock);
+    timRxPollCurrent = NULL;
+    epicsMutexUnlock(timRxPollLock);
+    epicsEventSignal(timRxPollDoneEvent);
+}
+
+/* Poll scheduler thread. Sleeps until the earliest sweep deadline of all
+ * registered receivers and runs the sweeps that are due. Works on a copy
+ * of timRxPollDrivers and claims one driver at a time, see
+ * pollSchedulerClaim */
+static void pollSchedulerTaskC(void *drvPvt)
+{
+    std::vector<drvTimRx *> drivers;
+    epicsFloat64 wait = 0.0;
+    epicsFloat64 drvWait = 0.0;
+    epicsTimeStamp now;
+
+    while (1) {
+        epicsMutexMustLock(timRxPollLock);
+        drivers = timRxPollDrivers;
+        epicsMutexUnlock(timRxPollLock);
+
+        epicsTimeGetCurrent(&now);
+        wait = -1.0;
+        for (size_t i = 0; i < drivers.size(); ++i) {
+            if (!pollSchedulerClaim(drivers[i])) {
+                continue;
+            }
+            drvWait = drivers[i]->pollTimeToNext(&now);
+            pollSchedulerRelease();
+            if (drvWait >= 0.0 && (wait < 0.0 || drvWait < wait)) {
+                wait = drvWait;
+            }
+        }
+
+        /* No sweep enabled on any receiver. Wait for a new period */
+        if (wait < 0.0) {
+            epicsEventWait(timRxPollEvent);
+        }
+        else if (wait > 0.0) {
+            epicsEventWaitWithTimeout(timRxPollEvent, wait);
+        }
+
+        /* Only the receivers with a sweep due. Their schedules are
+         * staggered, so most wakeups are for a single receiver */
+        epicsMutexMustLock(timRxPollLock);
+        drivers = timRxPollDrivers;
+        epicsMutexUnlock(timRxPollLock);
+
+        for (size_t i = 0; i < drivers.size(); ++i) {
+            if (!pollSchedulerClaim(drivers[i])) {
+                continue;
+            }
+            epicsTimeGetCurrent(&now);
+            if (drivers[i]->pollTimeToNext(&now) == 0.0) {
+                drivers[i]->pollRun(&now);
+            }
+            pollSchedulerRelease();
+        }
+    }
+}
+
+static void connTaskC(void *drvPvt)
+{
+    drvTimRx *pPvt = (drvTimRx *)drvPvt;
+    pPvt->connTask();
+}
+
+static void flushTaskC(void *drvPvt)
+{
+    flushWorker_t *worker = (flushWorker_t *)drvPvt;
+    worker->driver->flushTask(worker);
+}
+
 static void exitHandlerC(void *pPvt)
 {
     drvTimRx *pdrvTimRx = (drvTimRx *)pPvt;
@@ -187,17 +760,257 @@ get_service_id_err:
     return status;
 }
 
+/* Return the full service name previously resolved for functionId, or NULL
+ * if the function does not talk to hardware */
+char *drvTimRx::getServiceName (int functionId) const
+{
+    size_t idx = functionId - FIRST_COMMAND;
+
+    if (idx >= timRxServiceNames.size()) {
+        return NULL;
+    }
+
+    return timRxServiceNames[idx];
+}
+
+/* Return the hardware function registered for functionId, or NULL if the
+ * parameter is only kept in the parameter library */
+const functionsHw_t *drvTimRx::getHwFunc (int functionId) const
+{
+    size_t idx = functionId - FIRST_COMMAND;
+
+    if (idx >= timRxNumParams ||
+            timRxParams[idx].hwFunc.type == functionsHwNone) {
+        return NULL;
+    }
+
+    return &timRxParams[idx].hwFunc;
+}
+
+/* Return the TIM_RX_PARAM_* flags registered for functionId */
+unsigned drvTimRx::getParamFlags (int functionId) const
+{
+    size_t idx = functionId - FIRST_COMMAND;
+
+    if (idx >= timRxNumParams) {
+        return 0;
+    }
+
+    return timRxParams[idx].flags;
+}
+
+/* Create every parameter in the registry. Indexes must come out contiguous
+ * and in registry order, as getHwFunc() and getServiceName() rely on it */
+asynStatus drvTimRx::createParams()
+{
+    static const char *functionName = "createParams";
+    asynStatus status = asynSuccess;
+
+    if (timRxNumParams != (size_t) NUM_PARAMS) {
+        asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
+            "%s:%s: registry has %u entries, but %d parameters are declared\n",
+            driverName, functionName, (unsigned) timRxNumParams, (int) NUM_PARAMS);
+        return asynError;
+    }
+
+    for (size_t i = 0; i < timRxNumParams; ++i) {
+        status = createParam(timRxParams[i].name, timRxParams[i].type,
+                &(this->*timRxParams[i].index));
+        if (status != asynSuccess) {
+            return status;
+        }
+
+        if (this->*timRxParams[i].index != FIRST_COMMAND + (int) i) {
+            asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
+                "%s:%s: parameter %s created out of registry order\n",
+                driverName, functionName, timRxParams[i].name);
+            return asynError;
+        }
+    }
+
+    return status;
+}
+
+void drvTimRx::setInitialParams()
+{
+    for (size_t i = 0; i < timRxNumParams; ++i) {
+        for (int addr = 0; addr < timRxParams[i].numAddr; ++addr) {
+            switch (timRxParams[i].type) {
+                case asynParamUInt32Digital:
+                    setUIntDigitalParam(addr, this->*timRxParams[i].index,
+                            0, 0xFFFFFFFF);
+                break;
+
+                case asynParamFloat64:
+                    setDoubleParam(addr, this->*timRxParams[i].index, 0.0);
+                break;
+
+                default:
+                break;
+            }
+        }
+    }
+}
+
+/* Read every register mapped to hardware, for every channel, into the
+ * parameter library and the register shadow. With the shadow filled,
+ * restoring a value the hardware already holds does not reach hardware.
+ * Registers that fail to read keep their initial value and get an alarm.
+ * Must be called with the driver lock held */
+asynStatus drvTimRx::snapshotHw()
+{
+    static const char *functionName = "snapshotHw";
+    asynStatus status = asynSuccess;
+    asynStatus readStatus = asynSuccess;
+    functionsArgs_t functionArgs = {0};
+    unsigned numFailed = 0;
+
+    for (size_t i = 0; i < timRxNumParams; ++i) {
+        int functionId = this->*timRxParams[i].index;
+
+        if (getHwFunc(functionId) == NULL) {
+            continue;
+        }
+
+        for (int addr = 0; addr < timRxParams[i].numAddr; ++addr) {
+            functionArgs.argUInt32 = 0;
+            readStatus = executeHwReadFunction(functionId, addr, functionArgs);
+            /* No read function. Nothing to seed */
+            if (readStatus == asynDisabled) {
+                break;
+            }
+
+            if (readStatus == asynSuccess) {
+                if (timRxParams[i].type == asynParamFloat64) {
+                    setDoubleParam(addr, functionId, functionArgs.argFloat64);
+                }
+                else {
+                    setUIntDigitalParam(addr, functionId, functionArgs.argUInt32,
+                            0xFFFFFFFF);
+                }
+                storeRegShadow(functionId, addr, functionArgs);
+            }
+            else {
+                ++numFailed;
+                status = readStatus;
+            }
+            setParamStatus(addr, functionId, readStatus);
+        }
+    }
+
+    /* Seed the Si57x shadows from the registers just read */
+    for (int osc = 0; osc < si57xNumOsc; ++osc) {
+        const si57xParams_t &params = si57xParams[osc];
+        const regShadow_t &n1 = regShadow[(params.n1 - FIRST_COMMAND)*MAX_ADDR];
+        const regShadow_t &hsDiv = regShadow[(params.hsDiv - FIRST_COMMAND)*MAX_ADDR];
+        const regShadow_t &rfreqLo = regShadow[(params.rfreqLo - FIRST_COMMAND)*MAX_ADDR];
+        const regShadow_t &rfreqHi = regShadow[(params.rfreqHi - FIRST_COMMAND)*MAX_ADDR];
+
+        if (n1.valid && hsDiv.valid && rfreqLo.valid && rfreqHi.valid) {
+            updateSi57xShadow(osc, n1.value.argUInt32, hsDiv.value.argUInt32,
+                    rfreqLo.value.argUInt32, rfreqHi.value.argUInt32);
+        }
+    }
+
+    if (numFailed > 0) {
+        asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
+            "%s:%s: %u registers could not be read\n",
+            driverName, functionName, numFailed);
+    }
+
+    publishTrigTimes();
+    publishPackedAll();
+
+    hwSnapshotDone = true;
+    return status;
+}
+
+/* Return the interned full service name for serviceName, creating it
+ * if this is the first time it is requested */
+char *drvTimRx::internServiceName(const char *serviceName)
+{
+    static const char *functionName = "internServiceName";
+    char fullServiceName[SERVICE_NAME_SIZE];
+    char *service = NULL;
+    asynStatus status = asynSuccess;
+
+    status = getFullServiceName (this->timRxNumber, 0, serviceName,
+            fullServiceName, sizeof(fullServiceName));
+    if (status) {
+        asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
+            "%s:%s: error calling getFullServiceName, status=%d\n",
+            driverName, functionName, status);
+        goto get_service_err;
+    }
+
+    for (size_t i = 0; i < timRxServicePool.size(); ++i) {
+        if (strcmp(timRxServicePool[i], fullServiceName) == 0) {
+            return timRxServicePool[i];
+        }
+    }
+
+    service = epicsStrDup(fullServiceName);
+    timRxServicePool.push_back(service);
+
+get_service_err:
+    return service;
+}
+
+/* Resolve every mapped (service, core) pair into timRxServiceNames. timRxNumber
+ * and boardMap never change after construction, so the hot path only has to
+ * index this table */
+asynStatus drvTimRx::buildServiceNameTable()
+{
+    static const char *functionName = "buildServiceNameTable";
+    asynStatus status = asynSuccess;
+    const char *funcService = NULL;
+    char *service = NULL;
+
+    timRxServiceNames.assign(timRxNumParams, NULL);
+
+    for (size_t i = 0; i < timRxNumParams; ++i) {
+        funcService = timRxParams[i].hwFunc.getServiceName();
+        if (funcService == NULL) {
+            continue;
+        }
+
+        service = internServiceName(funcService);
+        if (service == NULL) {
+            asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
+                "%s:%s: error interning service name %s\n",
+                driverName, functionName, funcService);
+            status = asynError;
+            goto intern_service_err;
+        }
+        timRxServiceNames[i] = service;
+    }
+
+intern_service_err:
+    return status;
+}
+
+void drvTimRx::destroyServiceNameTable()
+{
+    for (size_t i = 0; i < timRxServicePool.size(); ++i) {
+        free (timRxServicePool[i]);
+    }
+    timRxServicePool.clear();
+    timRxServiceNames.clear();
+}
+
 /** Constructor for the drvTimRx class.
  * Calls constructor for the asynPortDriver base class.
  * \param[in] portName The name of the asyn port driver to be created.
  * \param[in] endpoint The device address string ]
  * */
 drvTimRx::drvTimRx(const char *portName, const char *endpoint, int timRxNumber,
-        int verbose, int timeout)
+        int verbose, int timeout, int numWorkers)
    : asynPortDriver(portName,
                     MAX_ADDR, /* maxAddr */
-                    asynUInt32DigitalMask | asynFloat64Mask  | asynDrvUserMask,    /* Interface mask     */
-                    asynUInt32DigitalMask | asynFloat64Mask ,                      /* Interrupt mask     */
+                    asynUInt32DigitalMask | asynFloat64Mask | asynInt64Mask |
+                        asynInt32ArrayMask | asynDrvUserMask,                      /* Interface mask     */
+                    asynUInt32DigitalMask | asynFloat64Mask | asynInt64Mask |
+                        asynInt32ArrayMask,                                        /* Interrupt mask     */
                     ASYN_CANBLOCK | ASYN_MULTIDEVICE, /* asynFlags.  This driver blocks it is multi-device */
                     1, /* Autoconnect */
                     0, /* Default priority */
@@ -206,6 +1019,45 @@ drvTimRx::drvTimRx(const char *portName, const char *endpoint, int timRxNumber,
     asynStatus status;
     const char *functionName = "drvTimRx";
 
+    epicsTimeGetCurrent(&createTime);
+
+    timRxClient = NULL;
+    timRxSharedClient = NULL;
+    pollRegistered = false;
+    writeCoalesced = 0;
+    flushLatencyMax = 0.0;
+    flushLatencySum = 0.0;
+    flushLatencies = 0;
+    pollReadClient = NULL;
+    pollReadsLeft = 0;
+    pollReadTimeouts = 0;
+    pollReadThreshold = 0;
+    pollReadDoneEvent = NULL;
+    connEvent = NULL;
+    connDoneEvent = NULL;
+    connFirstEvent = NULL;
+    hwSnapshotDone = false;
+    breakerState = breakerClosed;
+    breakerFailures = 0;
+    breakerTrips = 0;
+    breakerOpenTotal = 0.0;
+    memset(laneStats, 0, sizeof(laneStats));
+    traceRing.assign(TIM_RX_TRACE_SIZE, traceEntry_t());
+    traceHead = 0;
+    initLatParams();
+    clientHoldDepth = 0;
+    hwIoSlot = -1;
+    hwIoSeq = 0;
+    lockDepth = 0;
+    resetLockStats();
+    for (int i = 0; i < TIM_RX_REG_LOCK_STRIPES; ++i) {
+        regLocks[i] = epicsMutexMustCreate();
+    }
+    memset(cntState, 0, sizeof(cntState));
+    regShadowHits = 0;
+    regShadowMisses = 0;
+    writeElided = 0;
+
     /* Create portName so we can create a new AsynUser later */
     timRxPortName = epicsStrDup(portName);
 
@@ -230,244 +1082,113 @@ drvTimRx::drvTimRx(const char *portName, const char *endpoint, int timRxNumber,
     this->verbose = verbose;
     this->timeout = timeout;
 
-    /* Create parameters */
-    createParam(P_TimRxLinkStatusString,   asynParamUInt32Digital,         &P_TimRxLinkStatus);
-    createParam(P_TimRxRxenStatusString,   asynParamUInt32Digital,         &P_TimRxRxenStatus);
-    createParam(P_TimRxRefClkLockedString,   asynParamUInt32Digital,         &P_TimRxRefClkLocked);
-    createParam(P_TimRxEvrenString,   asynParamUInt32Digital,         &P_TimRxEvren);
-    createParam(P_TimRxAliveString,   asynParamUInt32Digital,         &P_TimRxAlive);
-
-    createParam(P_TimRxAmcEnString,   asynParamUInt32Digital,         &P_TimRxAmcEn);
-    createParam(P_TimRxAmcPolString,   asynParamUInt32Digital,         &P_TimRxAmcPol);
-    createParam(P_TimRxAmcLogString,   asynParamUInt32Digital,         &P_TimRxAmcLog);
-    createParam(P_TimRxAmcItlString,   asynParamUInt32Digital,         &P_TimRxAmcItl);
-    createParam(P_TimRxAmcSrcString,   asynParamUInt32Digital,         &P_TimRxAmcSrc);
-    createParam(P_TimRxAmcDirString,   asynParamUInt32Digital,         &P_TimRxAmcDir);
-    createParam(P_TimRxAmcCntRstString,   asynParamUInt32Digital,         &P_TimRxAmcCntRst);
-    createParam(P_TimRxAmcPulsesString,   asynParamUInt32Digital,         &P_TimRxAmcPulses);
-    createParam(P_TimRxAmcCntString,   asynParamUInt32Digital,         &P_TimRxAmcCnt);
-    createParam(P_TimRxAmcEvtString,   asynParamUInt32Digital,         &P_TimRxAmcEvt);
-    createParam(P_TimRxAmcDlyString,   asynParamUInt32Digital,         &P_TimRxAmcDly);
-    createParam(P_TimRxAmcWdtString,   asynParamUInt32Digital,         &P_TimRxAmcWdt);
-
-    createParam(P_TimRxFmc1EnString,   asynParamUInt32Digital,         &P_TimRxFmc1En);
-    createParam(P_TimRxFmc1PolString,   asynParamUInt32Digital,         &P_TimRxFmc1Pol);
-    createParam(P_TimRxFmc1LogString,   asynParamUInt32Digital,         &P_TimRxFmc1Log);
-    createParam(P_TimRxFmc1ItlString,   asynParamUInt32Digital,         &P_TimRxFmc1Itl);
-    createParam(P_TimRxFmc1SrcString,   asynParamUInt32Digital,         &P_TimRxFmc1Src);
-    createParam(P_TimRxFmc1DirString,   asynParamUInt32Digital,         &P_TimRxFmc1Dir);
-    createParam(P_TimRxFmc1CntRstString,   asynParamUInt32Digital,         &P_TimRxFmc1CntRst);
-    createParam(P_TimRxFmc1PulsesString,   asynParamUInt32Digital,         &P_TimRxFmc1Pulses);
-    createParam(P_TimRxFmc1CntString,   asynParamUInt32Digital,         &P_TimRxFmc1Cnt);
-    createParam(P_TimRxFmc1EvtString,   asynParamUInt32Digital,         &P_TimRxFmc1Evt);
-    createParam(P_TimRxFmc1DlyString,   asynParamUInt32Digital,         &P_TimRxFmc1Dly);
-    createParam(P_TimRxFmc1WdtString,   asynParamUInt32Digital,         &P_TimRxFmc1Wdt);
-
-    createParam(P_TimRxFmc2EnString,   asynParamUInt32Digital,         &P_TimRxFmc2En);
-    createParam(P_TimRxFmc2PolString,   asynParamUInt32Digital,         &P_TimRxFmc2Pol);
-    createParam(P_TimRxFmc2LogString,   asynParamUInt32Digital,         &P_TimRxFmc2Log);
-    createParam(P_TimRxFmc2ItlString,   asynParamUInt32Digital,         &P_TimRxFmc2Itl);
-    createParam(P_TimRxFmc2SrcString,   asynParamUInt32Digital,         &P_TimRxFmc2Src);
-    createParam(P_TimRxFmc2DirString,   asynParamUInt32Digital,         &P_TimRxFmc2Dir);
-    createParam(P_TimRxFmc2CntRstString,   asynParamUInt32Digital,         &P_TimRxFmc2CntRst);
-    createParam(P_TimRxFmc2PulsesString,   asynParamUInt32Digital,         &P_TimRxFmc2Pulses);
-    createParam(P_TimRxFmc2CntString,   asynParamUInt32Digital,         &P_TimRxFmc2Cnt);
-    createParam(P_TimRxFmc2EvtString,   asynParamUInt32Digital,         &P_TimRxFmc2Evt);
-    createParam(P_TimRxFmc2DlyString,   asynParamUInt32Digital,         &P_TimRxFmc2Dly);
-    createParam(P_TimRxFmc2WdtString,   asynParamUInt32Digital,         &P_TimRxFmc2Wdt);
-
-    createParam(P_TimRxRtmFreqKpString,   asynParamUInt32Digital,         &P_TimRxRtmFreqKp);
-    createParam(P_TimRxRtmFreqKiString,   asynParamUInt32Digital,         &P_TimRxRtmFreqKi);
-    createParam(P_TimRxRtmPhaseKpString,   asynParamUInt32Digital,         &P_TimRxRtmPhaseKp);
-    createParam(P_TimRxRtmPhaseKiString,   asynParamUInt32Digital,         &P_TimRxRtmPhaseKi);
-    createParam(P_TimRxRtmPhaseNavgString,   asynParamUInt32Digital,         &P_TimRxRtmPhaseNavg);
-    createParam(P_TimRxRtmPhaseDivExpString,   asynParamUInt32Digital,         &P_TimRxRtmPhaseDivExp);
-    createParam(P_TimRxRtmRfreqHiString,   asynParamUInt32Digital,         &P_TimRxRtmRfreqHi);
-    createParam(P_TimRxRtmRfreqLoString,   asynParamUInt32Digital,         &P_TimRxRtmRfreqLo);
-    createParam(P_TimRxRtmN1String,   asynParamUInt32Digital,         &P_TimRxRtmN1);
-    createParam(P_TimRxRtmHsDivString,   asynParamUInt32Digital,         &P_TimRxRtmHsDiv);
-    createParam(P_TimRxRtmSi57xFreqString,   asynParamUInt32Digital,         &P_TimRxRtmSi57xFreq);
-
-    createParam(P_TimRxAfcFreqKpString,   asynParamUInt32Digital,         &P_TimRxAfcFreqKp);
-    createParam(P_TimRxAfcFreqKiString,   asynParamUInt32Digital,         &P_TimRxAfcFreqKi);
-    createParam(P_TimRxAfcPhaseKpString,   asynParamUInt32Digital,         &P_TimRxAfcPhaseKp);
-    createParam(P_TimRxAfcPhaseKiString,   asynParamUInt32Digital,         &P_TimRxAfcPhaseKi);
-    createParam(P_TimRxAfcPhaseNavgString,   asynParamUInt32Digital,         &P_TimRxAfcPhaseNavg);
-    createParam(P_TimRxAfcPhaseDivExpString,   asynParamUInt32Digital,         &P_TimRxAfcPhaseDivExp);
-    createParam(P_TimRxAfcRfreqHiString,   asynParamUInt32Digital,         &P_TimRxAfcRfreqHi);
-    createParam(P_TimRxAfcRfreqLoString,   asynParamUInt32Digital,         &P_TimRxAfcRfreqLo);
-    createParam(P_TimRxAfcN1String,   asynParamUInt32Digital,         &P_TimRxAfcN1);
-    createParam(P_TimRxAfcHsDivString,   asynParamUInt32Digital,         &P_TimRxAfcHsDiv);
-    createParam(P_TimRxAfcSi57xFreqString,   asynParamUInt32Digital,         &P_TimRxAfcSi57xFreq);
-
-    /* TimRx Int32 Functions mapping. Functions not mapped here are just written
-     * to the parameter library */
-    timRxHwFunc.emplace(P_TimRxLinkStatus,    timRxSetGetLinkStatusFunc);
-    timRxHwFunc.emplace(P_TimRxRxenStatus,    timRxSetGetRxenStatusFunc);
-    timRxHwFunc.emplace(P_TimRxRefClkLocked,    timRxSetGetRefClkLockedFunc);
-    timRxHwFunc.emplace(P_TimRxEvren,    timRxSetGetEvrenFunc);
-    timRxHwFunc.emplace(P_TimRxAlive,    timRxSetGetAliveFunc);
-
-    timRxHwFunc.emplace(P_TimRxAmcEn,    timRxSetGetAmcEnFunc);
-    timRxHwFunc.emplace(P_TimRxAmcPol,    timRxSetGetAmcPolFunc);
-    timRxHwFunc.emplace(P_TimRxAmcLog,    timRxSetGetAmcLogFunc);
-    timRxHwFunc.emplace(P_TimRxAmcItl,    timRxSetGetAmcItlFunc);
-    timRxHwFunc.emplace(P_TimRxAmcSrc,    timRxSetGetAmcSrcFunc);
-    timRxHwFunc.emplace(P_TimRxAmcDir,    timRxSetGetAmcDirFunc);
-    timRxHwFunc.emplace(P_TimRxAmcCntRst,    timRxSetGetAmcCntRstFunc);
-    timRxHwFunc.emplace(P_TimRxAmcPulses,    timRxSetGetAmcPulsesFunc);
-    timRxHwFunc.emplace(P_TimRxAmcCnt,    timRxSetGetAmcCntFunc);
-    timRxHwFunc.emplace(P_TimRxAmcEvt,    timRxSetGetAmcEvtFunc);
-    timRxHwFunc.emplace(P_TimRxAmcDly,    timRxSetGetAmcDlyFunc);
-    timRxHwFunc.emplace(P_TimRxAmcWdt,    timRxSetGetAmcWdtFunc);
-
-    timRxHwFunc.emplace(P_TimRxFmc1En,    timRxSetGetFmc1EnFunc);
-    timRxHwFunc.emplace(P_TimRxFmc1Pol,    timRxSetGetFmc1PolFunc);
-    timRxHwFunc.emplace(P_TimRxFmc1Log,    timRxSetGetFmc1LogFunc);
-    timRxHwFunc.emplace(P_TimRxFmc1Itl,    timRxSetGetFmc1ItlFunc);
-    timRxHwFunc.emplace(P_TimRxFmc1Src,    timRxSetGetFmc1SrcFunc);
-    timRxHwFunc.emplace(P_TimRxFmc1Dir,    timRxSetGetFmc1DirFunc);
-    timRxHwFunc.emplace(P_TimRxFmc1CntRst,    timRxSetGetFmc1CntRstFunc);
-    timRxHwFunc.emplace(P_TimRxFmc1Pulses,    timRxSetGetFmc1PulsesFunc);
-    timRxHwFunc.emplace(P_TimRxFmc1Cnt,    timRxSetGetFmc1CntFunc);
-    timRxHwFunc.emplace(P_TimRxFmc1Evt,    timRxSetGetFmc1EvtFunc);
-    timRxHwFunc.emplace(P_TimRxFmc1Dly,    timRxSetGetFmc1DlyFunc);
-    timRxHwFunc.emplace(P_TimRxFmc1Wdt,    timRxSetGetFmc1WdtFunc);
-
-    timRxHwFunc.emplace(P_TimRxFmc2En,    timRxSetGetFmc2EnFunc);
-    timRxHwFunc.emplace(P_TimRxFmc2Pol,    timRxSetGetFmc2PolFunc);
-    timRxHwFunc.emplace(P_TimRxFmc2Log,    timRxSetGetFmc2LogFunc);
-    timRxHwFunc.emplace(P_TimRxFmc2Itl,    timRxSetGetFmc2ItlFunc);
-    timRxHwFunc.emplace(P_TimRxFmc2Src,    timRxSetGetFmc2SrcFunc);
-    timRxHwFunc.emplace(P_TimRxFmc2Dir,    timRxSetGetFmc2DirFunc);
-    timRxHwFunc.emplace(P_TimRxFmc2CntRst,    timRxSetGetFmc2CntRstFunc);
-    timRxHwFunc.emplace(P_TimRxFmc2Pulses,    timRxSetGetFmc2PulsesFunc);
-    timRxHwFunc.emplace(P_TimRxFmc2Cnt,    timRxSetGetFmc2CntFunc);
-    timRxHwFunc.emplace(P_TimRxFmc2Evt,    timRxSetGetFmc2EvtFunc);
-    timRxHwFunc.emplace(P_TimRxFmc2Dly,    timRxSetGetFmc2DlyFunc);
-    timRxHwFunc.emplace(P_TimRxFmc2Wdt,    timRxSetGetFmc2WdtFunc);
-
-    timRxHwFunc.emplace(P_TimRxRtmFreqKp,    timRxSetGetRtmFreqKpFunc);
-    timRxHwFunc.emplace(P_TimRxRtmFreqKi,    timRxSetGetRtmFreqKiFunc);
-    timRxHwFunc.emplace(P_TimRxRtmPhaseKp,    timRxSetGetRtmPhaseKpFunc);
-    timRxHwFunc.emplace(P_TimRxRtmPhaseKi,    timRxSetGetRtmPhaseKiFunc);
-    timRxHwFunc.emplace(P_TimRxRtmPhaseNavg,    timRxSetGetRtmPhaseNavgFunc);
-    timRxHwFunc.emplace(P_TimRxRtmPhaseDivExp,    timRxSetGetRtmPhaseDivExpFunc);
-    timRxHwFunc.emplace(P_TimRxRtmRfreqHi,    timRxSetGetRtmRfreqHiFunc);
-    timRxHwFunc.emplace(P_TimRxRtmRfreqLo,    timRxSetGetRtmRfreqLoFunc);
-    timRxHwFunc.emplace(P_TimRxRtmN1,    timRxSetGetRtmN1Func);
-    timRxHwFunc.emplace(P_TimRxRtmHsDiv,    timRxSetGetRtmHsDivFunc);
-    timRxHwFunc.emplace(P_TimRxAfcFreqKp,    timRxSetGetAfcFreqKpFunc);
-    timRxHwFunc.emplace(P_TimRxAfcFreqKi,    timRxSetGetAfcFreqKiFunc);
-    timRxHwFunc.emplace(P_TimRxAfcPhaseKp,    timRxSetGetAfcPhaseKpFunc);
-    timRxHwFunc.emplace(P_TimRxAfcPhaseKi,    timRxSetGetAfcPhaseKiFunc);
-    timRxHwFunc.emplace(P_TimRxAfcPhaseNavg,    timRxSetGetAfcPhaseNavgFunc);
-    timRxHwFunc.emplace(P_TimRxAfcPhaseDivExp,    timRxSetGetAfcPhaseDivExpFunc);
-    timRxHwFunc.emplace(P_TimRxAfcRfreqHi,    timRxSetGetAfcRfreqHiFunc);
-    timRxHwFunc.emplace(P_TimRxAfcRfreqLo,    timRxSetGetAfcRfreqLoFunc);
-    timRxHwFunc.emplace(P_TimRxAfcN1,    timRxSetGetAfcN1Func);
-    timRxHwFunc.emplace(P_TimRxAfcHsDiv,    timRxSetGetAfcHsDivFunc);
-
-
-    lock();
-    status = timRxClientConnect(this->pasynUserSelf);
-    unlock();
+    /* 0 is taken as the default of a single worker, so older startup
+     * scripts keep working */
+    if (numWorkers < 0 || numWorkers > TIM_RX_MAX_WORKERS) {
+        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+                "%s:%s drvTimRx invalid numWorkers %d. Must be between 1 and %d\n",
+                driverName, functionName, numWorkers, TIM_RX_MAX_WORKERS);
+        status = asynError;
+        goto invalid_num_workers_err;
+    }
+    this->numWorkers = (numWorkers > 0)? numWorkers : 1;
 
-    /* If we correct connect for this first time, liclient
-     * will ensure the reconnection to server if necessary, but we
-     * must succeed here or we must abort completely */
+    /* Create parameters from the registry */
+    status = createParams();
     if (status != asynSuccess) {
         asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
-            "%s:%s: error calling timRxClientConnect, status=%d\n",
+            "%s:%s: error calling createParams, status=%d\n",
             driverName, functionName, status);
-        exit(1);
+        goto create_params_err;
     }
 
-    /* Set the initial values of some parameters */
-    setUIntDigitalParam(P_TimRxLinkStatus,   0, 0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxRxenStatus,   0, 0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxRefClkLocked,   0, 0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxEvren,   0, 0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxAlive,   0, 0xFFFFFFFF);
+    /* Resolve full service names once, so hardware accesses don't need
+     * to format them */
+    status = buildServiceNameTable();
+    if (status != asynSuccess) {
+        asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
+            "%s:%s: error calling buildServiceNameTable, status=%d\n",
+            driverName, functionName, status);
+        goto build_service_name_table_err;
+    }
 
+    initRegShadow();
+
+    /* Set the initial values of the parameters, then overwrite the ones
+     * mapped to hardware with what the hardware holds */
+    setInitialParams();
+    setDoubleParam(P_TimRxStatusPollPeriod, TIM_RX_STATUS_POLL_PERIOD_DFLT);
+    setDoubleParam(P_TimRxCntPollPeriod, TIM_RX_CNT_POLL_PERIOD_DFLT);
+    setDoubleParam(P_TimRxWriteHoldoff, TIM_RX_WRITE_HOLDOFF_DFLT);
+    setDoubleParam(P_TimRxSi57xPollPeriod, TIM_RX_SI57X_POLL_PERIOD_DFLT);
+    setDoubleParam(P_TimRxShadowTtl, TIM_RX_SHADOW_TTL_DFLT);
+    setUIntDigitalParam(P_TimRxWriteElide, TIM_RX_WRITE_ELIDE_DFLT, 0xFFFFFFFF);
+    setDoubleParam(P_TimRxWriteElideAge, TIM_RX_WRITE_ELIDE_AGE_DFLT);
+    setUIntDigitalParam(P_TimRxBreakerThreshold, TIM_RX_BREAKER_THRESHOLD_DFLT, 0xFFFFFFFF);
+    setDoubleParam(P_TimRxFpgaClk, TIM_RX_FPGA_CLK_DFLT);
+    setUIntDigitalParam(P_TimRxHwUnlock, TIM_RX_HW_UNLOCK_DFLT, 0xFFFFFFFF);
+    setUIntDigitalParam(P_TimRxNumWorkers, this->numWorkers, 0xFFFFFFFF);
     for (int addr = 0; addr < MAX_AMC_TRIGGER_CH; ++addr) {
-      setUIntDigitalParam(addr, P_TimRxAmcEn,       0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxAmcPol,      0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxAmcLog,      0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxAmcItl,      0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxAmcSrc,      0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxAmcDir,      0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxAmcCntRst,   0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxAmcPulses,   0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxAmcCnt,      0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxAmcEvt,      0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxAmcDly,      0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxAmcWdt,      0, 0xFFFFFFFF);
+        setDoubleParam(addr, P_TimRxAmcRateWindow, TIM_RX_RATE_WINDOW_DFLT);
     }
-
     for (int addr = 0; addr < MAX_FMC1_TRIGGER_CH; ++addr) {
-      setUIntDigitalParam(addr, P_TimRxFmc1En,      0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxFmc1Pol,     0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxFmc1Log,     0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxFmc1Itl,     0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxFmc1Src,     0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxFmc1Dir,     0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxFmc1CntRst,  0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxFmc1Pulses,  0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxFmc1Cnt,     0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxFmc1Evt,     0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxFmc1Dly,     0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxFmc1Wdt,     0, 0xFFFFFFFF);
+        setDoubleParam(addr, P_TimRxFmc1RateWindow, TIM_RX_RATE_WINDOW_DFLT);
     }
-
     for (int addr = 0; addr < MAX_FMC2_TRIGGER_CH; ++addr) {
-      setUIntDigitalParam(addr, P_TimRxFmc2En,      0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxFmc2Pol,     0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxFmc2Log,     0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxFmc2Itl,     0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxFmc2Src,     0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxFmc2Dir,     0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxFmc2CntRst,  0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxFmc2Pulses,  0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxFmc2Cnt,     0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxFmc2Evt,     0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxFmc2Dly,     0, 0xFFFFFFFF);
-      setUIntDigitalParam(addr, P_TimRxFmc2Wdt,     0, 0xFFFFFFFF);
-    }
-
-    setUIntDigitalParam(P_TimRxRtmFreqKp,   0, 0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxRtmFreqKi,   0, 0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxRtmPhaseKp,   0, 0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxRtmPhaseKi,   0, 0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxRtmPhaseNavg,   0, 0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxRtmPhaseDivExp,   0, 0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxRtmRfreqHi,   0, 0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxRtmRfreqLo,   0, 0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxRtmN1,   0, 0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxRtmHsDiv,   0, 0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxRtmSi57xFreq,   0, 0xFFFFFFFF);
-
-    setUIntDigitalParam(P_TimRxAfcFreqKp,   0, 0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxAfcFreqKi,   0, 0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxAfcPhaseKp,   0, 0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxAfcPhaseKi,   0, 0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxAfcPhaseNavg,   0, 0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxAfcPhaseDivExp,   0, 0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxAfcRfreqHi,   0, 0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxAfcRfreqLo,   0, 0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxAfcN1,   0, 0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxAfcHsDiv,   0, 0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxAfcSi57xFreq,   0, 0xFFFFFFFF);
+        setDoubleParam(addr, P_TimRxFmc2RateWindow, TIM_RX_RATE_WINDOW_DFLT);
+    }
+    initSi57xShadow();
+    initTrigTimeParams();
+    initPackedParams();
 
     /* Do callbacks so higher layers see any changes. Call callbacks for every addr */
     for (int i = 0; i < MAX_ADDR; ++i) {
         callParamCallbacks(i);
     }
 
+    status = startPollTask();
+    if (status != asynSuccess) {
+        asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
+            "%s:%s: error calling startPollTask, status=%d\n",
+            driverName, functionName, status);
+        goto start_poll_task_err;
+    }
+
+    status = startFlushTask();
+    if (status != asynSuccess) {
+        asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
+            "%s:%s: error calling startFlushTask, status=%d\n",
+            driverName, functionName, status);
+        goto start_flush_task_err;
+    }
+
+    /* The board is reached and its configuration read by the connection
+     * manager, without the driver lock. See waitFirstConnect */
+    status = startConnTask();
+    if (status != asynSuccess) {
+        asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
+            "%s:%s: error calling startConnTask, status=%d\n",
+            driverName, functionName, status);
+        goto start_conn_task_err;
+    }
+
     epicsAtExit(exitHandlerC, this);
+    return;
 
+    /* Undo the steps above in reverse order, so a port that failed to
+     * start is not polled, has no flush threads and holds no client */
+start_conn_task_err:
+    stopFlushTask();
+start_flush_task_err:
+    stopPollTask();
+start_poll_task_err:
+    destroyServiceNameTable();
+build_service_name_table_err:
+create_params_err:
+invalid_num_workers_err:
 invalid_timRx_number_err:
     free (this->endpoint);
+    this->endpoint = NULL;
 endpoint_dup_err:
     return;
 }
@@ -479,6 +1200,11 @@ drvTimRx::~drvTimRx()
     asynStatus status = asynSuccess;
     const char *functionName = "~drvTimRx";
 
+    stopConnTask();
+    /* Sweeps may hand reads to the flush threads */
+    stopPollTask();
+    stopFlushTask();
+
     lock();
     status = timRxClientDisconnect(this->pasynUserSelf);
     unlock();
@@ -488,890 +1214,3634 @@ drvTimRx::~drvTimRx()
             driverName, functionName, status);
     }
 
+    for (int i = 0; i < TIM_RX_REG_LOCK_STRIPES; ++i) {
+        epicsMutexDestroy(regLocks[i]);
+    }
+
+    destroyServiceNameTable();
     free (this->endpoint);
     this->endpoint = NULL;
     free (this->timRxPortName);
     this->timRxPortName = NULL;
 }
 
-asynStatus drvTimRx::connect(asynUser* pasynUser)
+asynStatus drvTimRx::startPollTask()
 {
-    return timRxClientConnect(pasynUser);
-}
+    const char *functionName = "startPollTask";
 
-asynStatus drvTimRx::timRxClientConnect(asynUser* pasynUser)
-{
-    asynStatus status = asynSuccess;
-    const char *timRxLogFile = "stdout";
-    const char *functionName = "timRxClientConnect";
+    epicsThreadOnce(&timRxOnceId, timRxOnceC, NULL);
 
-    /* Connect TimRx */
-    if (timRxClient == NULL) {
-        timRxClient = halcs_client_new_time (endpoint, verbose, timRxLogFile, timeout);
-        if (timRxClient == NULL) {
-            asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
-                    "%s:%s timRxClientConnect failure to create timRxClient instance\n",
-                    driverName, functionName);
-            status = asynError;
-            goto create_halcs_client_err;
+    lock();
+    pollRestart = true;
+    pollCntSkipped = 0;
+    unlock();
+
+    epicsMutexMustLock(timRxPollLock);
+    if (!timRxPollThreadStarted) {
+        if (epicsThreadCreate("drvTimRxPoll", epicsThreadPriorityMedium,
+                    epicsThreadGetStackSize(epicsThreadStackMedium),
+                    (EPICSTHREADFUNC)pollSchedulerTaskC, NULL) == NULL) {
+            epicsMutexUnlock(timRxPollLock);
+            asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
+                "%s:%s: epicsThreadCreate failure\n",
+                driverName, functionName);
+            return asynError;
         }
+        timRxPollThreadStarted = true;
     }
 
-    asynPrint(this->pasynUserSelf, ASYN_TRACE_FLOW,
-        "%s:%s: Tim Rx client connected\n",
-        driverName, functionName);
-
-    pasynManager->exceptionConnect(pasynUser);
+    timRxPollDrivers.push_back(this);
+    pollRegistered = true;
+    epicsMutexUnlock(timRxPollLock);
 
-    return status;
+    epicsEventSignal(timRxPollEvent);
 
-create_halcs_client_err:
-    return status;
+    return asynSuccess;
 }
 
-asynStatus drvTimRx::disconnect(asynUser* pasynUser)
+void drvTimRx::stopPollTask()
 {
-    return timRxClientDisconnect(pasynUser);
-}
+    if (!pollRegistered) {
+        return;
+    }
 
-asynStatus drvTimRx::timRxClientDisconnect(asynUser* pasynUser)
+    /* Blocks until a sweep in progress is done. The scheduler does not
+     * claim this driver again once it is out of timRxPollDrivers */
+    epicsMutexMustLock(timRxPollLock);
+    for (size_t i = 0; i < timRxPollDrivers.size(); ++i) {
+        if (timRxPollDrivers[i] == this) {
+            timRxPollDrivers.erase(timRxPollDrivers.begin() + i);
+            break;
+        }
+    }
+    while (timRxPollCurrent == this) {
+        epicsMutexUnlock(timRxPollLock);
+        epicsEventWait(timRxPollDoneEvent);
+        epicsMutexMustLock(timRxPollLock);
+    }
+    epicsMutexUnlock(timRxPollLock);
+    /* The event may have been meant for another receiver being stopped */
+    epicsEventSignal(timRxPollDoneEvent);
+
+    pollRegistered = false;
+}
+
+/* Advance a poller deadline by one period. If the sweep overran one or
+ * more periods, the missed deadlines are dropped, so the schedule does
+ * not try to catch up with back-to-back sweeps. Returns the number of
+ * dropped deadlines */
+static epicsUInt32 pollScheduleNext(epicsTimeStamp *next, epicsFloat64 period,
+        const epicsTimeStamp *now)
 {
-    asynPrint(this->pasynUserSelf, ASYN_TRACE_FLOW,
-            "%s: calling timRxClientDisconnect\n",
-            driverName);
-    asynStatus status = asynSuccess;
+    epicsUInt32 skipped = 0;
+    double late = 0.0;
+
+    epicsTimeAddSeconds(next, period);
+    late = epicsTimeDiffInSeconds(now, next);
+    if (late >= 0.0) {
+        skipped = (epicsUInt32)(late/period) + 1;
+        epicsTimeAddSeconds(next, skipped*period);
+    }
+
+    return skipped;
+}
+
+/* Fold the deadline of one sweep into wait, the time until the earliest
+ * deadline so far (negative if none). Disabled sweeps (period of zero)
+ * are ignored */
+static epicsFloat64 pollEarliest(epicsFloat64 wait, epicsFloat64 period,
+        const epicsTimeStamp *next, const epicsTimeStamp *now)
+{
+    epicsFloat64 sweepWait = 0.0;
 
-    if (timRxClient != NULL) {
-        halcs_client_destroy (&timRxClient);
+    if (period <= 0.0) {
+        return wait;
     }
 
-    pasynManager->exceptionDisconnect(pasynUser);
-    return status;
+    sweepWait = epicsTimeDiffInSeconds(next, now);
+    sweepWait = (sweepWait > 0.0)? sweepWait : 0.0;
+    if (wait < 0.0 || sweepWait < wait) {
+        wait = sweepWait;
+    }
+
+    return wait;
 }
 
-/********************************************************************/
-/********************* Asyn overrided methods  **********************/
-/********************************************************************/
+/** Time until the next sweep of this receiver is due, or a negative value
+ * if all of them are disabled (period of zero). A pending period change
+ * restarts all schedules from now. Called by the poll scheduler */
+epicsFloat64 drvTimRx::pollTimeToNext(const epicsTimeStamp *now)
+{
+    epicsFloat64 statusPeriod = 0.0;
+    epicsFloat64 cntPeriod = 0.0;
+    epicsFloat64 si57xPeriod = 0.0;
+    epicsFloat64 wait = -1.0;
 
-/*
- * Asyn overrided methods that are called by higher layers
- */
+    lock();
+    getDoubleParam(P_TimRxStatusPollPeriod, &statusPeriod);
+    getDoubleParam(P_TimRxCntPollPeriod, &cntPeriod);
+    getDoubleParam(P_TimRxSi57xPollPeriod, &si57xPeriod);
+
+    if (pollRestart) {
+        pollNextStatus = *now;
+        pollNextCnt = *now;
+        pollNextSi57x = *now;
+        pollRestart = false;
+    }
 
-/** Called when asyn clients call pasynUInt32Digital->write().
- * For all parameters it sets the value in the parameter library and calls any registered callbacks..
- * \param[in] pasynUser pasynUser structure that encodes the reason and address.
- * \param[in] value Value to write. */
-asynStatus drvTimRx::writeUInt32Digital(asynUser *pasynUser, epicsUInt32 value,
-        epicsUInt32 mask)
+    wait = pollEarliest(wait, statusPeriod, &pollNextStatus, now);
+    wait = pollEarliest(wait, cntPeriod, &pollNextCnt, now);
+    wait = pollEarliest(wait, si57xPeriod, &pollNextSi57x, now);
+    unlock();
+
+    return wait;
+}
+
+/** Run the sweeps of this receiver that are due. Called by the poll
+ * scheduler. Every sweep reads its whole group at once, so that the
+ * records get a coherent snapshot with a single timestamp instead of
+ * queueing one blocking request each on the port */
+void drvTimRx::pollRun(const epicsTimeStamp *now)
 {
-    int function = pasynUser->reason;
-    asynStatus status = asynSuccess;
-    int addr = 0;
-    const char *paramName;
-    const char* functionName = "writeUInt32Digital";
+    epicsFloat64 statusPeriod = 0.0;
+    epicsFloat64 cntPeriod = 0.0;
+    epicsFloat64 si57xPeriod = 0.0;
+    epicsTimeStamp endTime;
 
-    /* Get channel for possible use */
-    status = getAddress(pasynUser, &addr);
-    if (status) {
-        epicsSnprintf(pasynUser->errorMessage, pasynUser->errorMessageSize,
-                "%s:%s: status=%d, function=%d, name=%s, value=%d",
-                driverName, functionName, status, function, paramName, value);
-        return status;
+    lock();
+    /* Schedules are restarted by pollTimeToNext */
+    if (pollRestart) {
+        unlock();
+        return;
     }
 
-    if (function >= FIRST_COMMAND) {
-        /* Set the parameter in the parameter library. */
-        setUIntDigitalParam(addr, function, value, mask);
-        /* Fetch the parameter string name for possible use in debugging */
-        getParamName(function, &paramName);
+    getDoubleParam(P_TimRxStatusPollPeriod, &statusPeriod);
+    getDoubleParam(P_TimRxCntPollPeriod, &cntPeriod);
+    getDoubleParam(P_TimRxSi57xPollPeriod, &si57xPeriod);
 
-        if (function == P_TimRxRtmSi57xFreq) {
-            status = setRtmSi57xFreq(value, addr);
-        }
-        else if (function == P_TimRxAfcSi57xFreq) {
-            status = setAfcSi57xFreq(value, addr);
-        }
-        else {
-            /* Do operation on HW. Some functions do not set anything on hardware */
-            status = setParam32(function, mask, addr);
-        }
+    if (statusPeriod > 0.0 && epicsTimeDiffInSeconds(now, &pollNextStatus) >= 0.0) {
+        pollStatus();
+        epicsTimeGetCurrent(&endTime);
+        pollScheduleNext(&pollNextStatus, statusPeriod, &endTime);
     }
-    else {
-        /* Call base class */
-        status = asynPortDriver::writeUInt32Digital(pasynUser, value, mask);
+
+    if (cntPeriod > 0.0 && epicsTimeDiffInSeconds(now, &pollNextCnt) >= 0.0) {
+        pollCounters();
+        epicsTimeGetCurrent(&endTime);
+        pollCntSkipped += pollScheduleNext(&pollNextCnt, cntPeriod, &endTime);
+        setUIntDigitalParam(P_TimRxCntPollSkipped, pollCntSkipped, 0xFFFFFFFF);
+        callParamCallbacks();
     }
 
-    /* Do callbacks so higher layers see any changes */
-    callParamCallbacks(addr);
+    /* Low rate refresh of the Si57x shadows, so that changes not made
+     * through this driver are eventually seen. While disconnected there is
+     * nothing to read, and the shadows are read again on connection */
+    if (si57xPeriod > 0.0 && epicsTimeDiffInSeconds(now, &pollNextSi57x) >= 0.0) {
+        if (timRxSharedClient != NULL) {
+            for (int osc = 0; osc < si57xNumOsc; ++osc) {
+                refreshSi57xShadow(osc);
+            }
+            callParamCallbacks();
+        }
+        epicsTimeGetCurrent(&endTime);
+        pollScheduleNext(&pollNextSi57x, si57xPeriod, &endTime);
+    }
 
-    if (status)
-        epicsSnprintf(pasynUser->errorMessage, pasynUser->errorMessageSize,
-                "%s:%s: status=%d, function=%d, name=%s, value=%d",
-                driverName, functionName, status, function, paramName, value);
-    else
-        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER,
-                "%s:%s: function=%d, name=%s, value=%d\n",
-                driverName, functionName, function, paramName, value);
-    return status;
+    publishLaneStats();
+    publishLockStats();
+    publishLatStats();
+    callParamCallbacks();
+    unlock();
 }
 
-/** Called when asyn clients call pasynUInt32Digital->read().
- * For all parameters it gets the value in the parameter library..
- * \param[in] pasynUser pasynUser structure that encodes the reason and address.
- * \param[out] value Value to read. */
-asynStatus drvTimRx::readUInt32Digital(asynUser *pasynUser, epicsUInt32 *value,
-        epicsUInt32 mask)
+/* Take a reference to the client for a sweep. The sweep reads hardware
+ * on the poll lane client without the driver lock, so the port is free
+ * to serve setpoints meanwhile. Must be called with the driver lock held */
+asynStatus drvTimRx::pollLaneBegin(timRxSharedClient_t **sharedClient)
 {
-    int function = pasynUser->reason;
-    asynStatus status = asynSuccess;
-    int addr = 0;
-    const char *functionName = "readUInt32Digital";
-    const char *paramName;
+    *sharedClient = NULL;
 
-    /* Get channel for possible use */
-    status = getAddress(pasynUser, &addr);
-    if (status) {
-        epicsSnprintf(pasynUser->errorMessage, pasynUser->errorMessageSize,
-                "%s:%s: status=%d, function=%d, name=%s",
-                driverName, functionName, status, function, paramName);
-        return status;
+    if (timRxSharedClient == NULL) {
+        return asynDisconnected;
     }
-    /* Fetch the parameter string name for possible use in debugging */
-    getParamName(function, &paramName);
 
-    if (function >= FIRST_COMMAND) {
-        if (function == P_TimRxRtmSi57xFreq) {
-            status = getRtmSi57xFreq(value, addr);
-        }
-        else if (function == P_TimRxAfcSi57xFreq) {
-            status = getAfcSi57xFreq(value, addr);
-        }
-        else {
-            /* Get parameter, possibly from HW */
-            status = getParam32(function, value, mask, addr);
-        }
-    }
-    else {
-        /* Call base class */
-        status = asynPortDriver::readUInt32Digital(pasynUser, value, mask);
+    if (breakerState != breakerClosed) {
+        return asynTimeout;
     }
 
-    if (status)
-        epicsSnprintf(pasynUser->errorMessage, pasynUser->errorMessageSize,
-                "%s:%s: status=%d, function=%d, name=%s",
-                driverName, functionName, status, function, paramName);
-    else
-        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER,
-                "%s:%s: function=%d, name=%s\n",
-                driverName, functionName, function, paramName);
+    timRxSharedClientRef(timRxSharedClient);
+    *sharedClient = timRxSharedClient;
 
-    return status;
+    return asynSuccess;
 }
 
-/** Called when asyn clients call pasynFloat64->write().
-  * \param[in] pasynUser pasynUser structure that encodes the reason and address.
-  * \param[in] value Value to read */
-asynStatus drvTimRx::writeFloat64(asynUser *pasynUser, epicsFloat64 value)
+void drvTimRx::pollLaneEnd(timRxSharedClient_t *sharedClient)
 {
-    int function = pasynUser->reason;
-    asynStatus status = asynSuccess;
-    int addr = 0;
-    const char *paramName;
-    const char* functionName = "writeFloat64";
+    if (sharedClient != NULL) {
+        timRxSharedClientRelease(sharedClient);
+    }
+}
 
-    /* Get channel for possible use */
-    status = getAddress(pasynUser, &addr);
-    if (status) {
-        epicsSnprintf(pasynUser->errorMessage, pasynUser->errorMessageSize,
-                "%s:%s: status=%d, function=%d, name=%s, value=%f",
-                driverName, functionName, status, function, paramName, value);
-        return status;
+/* Read one register on the poll lane client, or on the client of the
+ * given worker if it is not negative. Can be called without the driver
+ * lock. The time waited for the client and the number of sweeps found
+ * waiting are returned in wait and depth, the HALCS outcome in err */
+asynStatus drvTimRx::pollReadHw(timRxSharedClient_t *sharedClient, int worker,
+        int functionId, int addr, epicsUInt32 *value, epicsFloat64 *wait,
+        int *depth, halcs_client_err_e *err)
+{
+    const char *functionName = "pollReadHw";
+    const functionsHw_t *func = getHwFunc(functionId);
+    char *service = getServiceName(functionId);
+    halcs_client_t *client = sharedClient->pollClient;
+    epicsMutexId clientLock = sharedClient->pollLock;
+    int *clientLockWaiters = &sharedClient->pollLockWaiters;
+    int lane = lanePoll;
+    epicsTimeStamp startTime;
+    epicsTimeStamp endTime;
+    functionsArgs_t traceValue;
+
+    *wait = 0.0;
+    *depth = 0;
+    *err = HALCS_CLIENT_SUCCESS;
+
+    if (func == NULL || service == NULL) {
+        return asynDisabled;
     }
 
-    if (function >= FIRST_COMMAND) {
-        /* Set the parameter in the parameter library. */
-        setDoubleParam(addr, function, value);
-        /* Fetch the parameter string name for possible use in debugging */
-        getParamName(function, &paramName);
+    if (worker >= 0) {
+        client = sharedClient->workerClients[worker];
+        clientLock = sharedClient->workerLocks[worker];
+        clientLockWaiters = &sharedClient->workerLockWaiters[worker];
+        lane = numLanes + worker;
+    }
+
+    epicsTimeGetCurrent(&startTime);
+    *depth = epicsAtomicIncrIntT(clientLockWaiters) - 1;
+    epicsMutexMustLock(clientLock);
+    epicsAtomicDecrIntT(clientLockWaiters);
+    epicsTimeGetCurrent(&endTime);
+    *wait = epicsTimeDiffInSeconds(&endTime, &startTime);
+
+    epicsTimeGetCurrent(&startTime);
+    switch (func->type) {
+        case functionsHwInt32:
+            *err = func->int32.read(client, service, value);
+        break;
+
+        case functionsHwInt32Chan:
+            *err = func->int32Chan.read(client, service, addr, value);
+        break;
 
-        /* Do operation on HW. Some functions do not set anything on hardware */
-        status = setParamDouble(function, addr);
+        default:
+            epicsMutexUnlock(clientLock);
+            return asynDisabled;
     }
-    else {
-        /* Call base class */
-        status = asynPortDriver::writeFloat64(pasynUser, value);
+    epicsTimeGetCurrent(&endTime);
+    epicsMutexUnlock(clientLock);
+
+    traceValue.argUInt32 = *value;
+    traceRecord(functionId, addr, 0, lane, traceValue, &startTime, &endTime, *err);
+
+    if (*err != HALCS_CLIENT_SUCCESS) {
+        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+                "%s:%s: failure executing read function for service %s\n",
+                driverName, functionName, service);
+        return asynError;
     }
 
-    /* Do callbacks so higher layers see any changes */
-    callParamCallbacks(addr);
+    return asynSuccess;
+}
 
-    if (status)
-        epicsSnprintf(pasynUser->errorMessage, pasynUser->errorMessageSize,
-                "%s:%s: status=%d, function=%d, name=%s, value=%f",
-                driverName, functionName, status, function, paramName, value);
-    else
-        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER,
-                "%s:%s: function=%d, name=%s, value=%f\n",
-                driverName, functionName, function, paramName, value);
-    return status;
+/* Do one read of a sweep, see pollReadBatch. Can be called without the
+ * driver lock */
+void drvTimRx::pollReadOne(timRxSharedClient_t *sharedClient, int worker,
+        pollRead_t *read)
+{
+    /* The breaker is about to open, do not wait out the rest */
+    if ((epicsUInt32) epicsAtomicGetIntT(&pollReadTimeouts) >= pollReadThreshold) {
+        read->status = asynTimeout;
+        return;
+    }
+
+    read->status = pollReadHw(sharedClient, worker, read->functionId, read->addr,
+            &read->value, &read->wait, &read->depth, &read->err);
+    epicsTimeGetCurrent(&read->time);
+    read->called = true;
+    if (read->err == HALCS_CLIENT_ERR_TIMEOUT) {
+        epicsAtomicIncrIntT(&pollReadTimeouts);
+    }
+    else {
+        epicsAtomicSetIntT(&pollReadTimeouts, 0);
+    }
 }
 
-/** Called when asyn clients call pasynFloat64->read().
-  * \param[in] pasynUser pasynUser structure that encodes the reason and address.
-  * \param[in] value Value to read */
-asynStatus drvTimRx::readFloat64(asynUser *pasynUser, epicsFloat64 *value)
+/* Do the reads of a sweep on sharedClient, as taken by pollLaneBegin with
+ * outcome laneStatus. With several workers the reads are handed to the
+ * worker of their register, as the held writes are, so reads of
+ * independent registers run concurrently and the calls on one register
+ * stay in order. Otherwise they run in turn on the poll lane. Must be
+ * called with the driver lock held. The lock is released while reading */
+void drvTimRx::pollReadBatch(timRxSharedClient_t *sharedClient,
+        asynStatus laneStatus, pollRead_t *reads, size_t num)
 {
-    int function = pasynUser->reason;
-    asynStatus status = asynSuccess;
-    int addr = 0;
-    const char *paramName;
-    const char* functionName = "readFloat64";
+    int workers = 0;
+    int slot = 0;
+
+    for (size_t i = 0; i < num; ++i) {
+        reads[i].value = 0;
+        reads[i].status = laneStatus;
+        reads[i].called = false;
+        reads[i].err = HALCS_CLIENT_SUCCESS;
+    }
 
-    /* Get channel for possible use */
-    status = getAddress(pasynUser, &addr);
-    if (status) {
-        epicsSnprintf(pasynUser->errorMessage, pasynUser->errorMessageSize,
-                "%s:%s: status=%d, function=%d, name=%s",
-                driverName, functionName, status, function, paramName);
-        return status;
+    if (laneStatus != asynSuccess || num == 0) {
+        return;
     }
-    /* Fetch the parameter string name for possible use in debugging */
-    getParamName(function, &paramName);
 
-    /* Get double param, possibly from HW */
-    if (function >= FIRST_COMMAND) {
-        status = getParamDouble(function, value, addr);
+    /* Timeouts in a row, counting the ones before the sweep */
+    epicsAtomicSetIntT(&pollReadTimeouts, breakerFailures);
+    pollReadThreshold = getBreakerThreshold();
+
+    if (!flushTaskExit && !flushWorkers.empty()) {
+        workers = epicsAtomicGetIntT(&sharedClient->numWorkers);
+        workers = (workers < numWorkers)? workers : numWorkers;
     }
-    else {
-        /* Call base class */
-        status = asynPortDriver::readFloat64(pasynUser, value);
+
+    if (workers <= 1) {
+        unlock();
+        for (size_t i = 0; i < num; ++i) {
+            pollReadOne(sharedClient, -1, &reads[i]);
+        }
+        lock();
+        return;
     }
 
-    if (status)
-        epicsSnprintf(pasynUser->errorMessage, pasynUser->errorMessageSize,
-                "%s:%s: status=%d, function=%d, name=%s",
-                driverName, functionName, status, function, paramName);
-    else
-        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER,
-                "%s:%s: function=%d, name=%s\n",
-                driverName, functionName, function, paramName);
-    return status;
-}
+    pollReadClient = sharedClient;
+    epicsAtomicSetIntT(&pollReadsLeft, (int) num);
+    for (size_t i = 0; i < num; ++i) {
+        slot = (reads[i].functionId - FIRST_COMMAND)*MAX_ADDR + reads[i].addr;
+        flushWorkers[(slot % TIM_RX_REG_LOCK_STRIPES) % workers].pollReadList.push_back(&reads[i]);
+    }
+    signalFlushWorkers();
+    unlock();
 
-/********************************************************************/
-/************ Function Mapping Overloaded Write functions ***********/
-/********************************************************************/
+    epicsEventMustWait(pollReadDoneEvent);
 
-asynStatus drvTimRx::doExecuteHwWriteFunction(functionsFloat64_t &func, char *service,
-        int addr, functionsArgs_t &functionParam) const
+    lock();
+    pollReadClient = NULL;
+}
+
+/* Do the sweep reads handed to a worker. Must be called with the driver
+ * lock held, from the worker thread. The lock is released while reading */
+void drvTimRx::runPollReads(flushWorker_t *worker)
 {
-    const char *functionName = "doExecuteHwWriteFunction<functionsFloat64_t>";
-    halcs_client_err_e err = HALCS_CLIENT_SUCCESS;
-    int status = asynSuccess;
+    std::vector<pollRead_t *> reads;
+    timRxSharedClient_t *sharedClient = pollReadClient;
 
-    /* Execute registered function */
-    err = func.write(timRxClient, service, functionParam.argFloat64);
-    if (err != HALCS_CLIENT_SUCCESS) {
-        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
-                "%s:%s: failure executing write function for service %s,"
-                "param = %f\n",
-                driverName, functionName, service, functionParam.argFloat64);
-        status = asynError;
-        goto halcs_set_func_param_err;
+    if (worker->pollReadList.empty()) {
+        return;
     }
 
-halcs_set_func_param_err:
-    return (asynStatus) status;
+    reads.swap(worker->pollReadList);
+    unlock();
+    for (size_t i = 0; i < reads.size(); ++i) {
+        pollReadOne(sharedClient, worker->index, reads[i]);
+        if (epicsAtomicDecrIntT(&pollReadsLeft) == 0) {
+            epicsEventSignal(pollReadDoneEvent);
+        }
+    }
+    lock();
 }
 
-asynStatus drvTimRx::doExecuteHwWriteFunction(functionsInt32Chan_t &func, char *service,
-        int addr, functionsArgs_t &functionParam) const
+/* Read the status group from hardware and publish it. Must be called
+ * with the driver lock held. The lock is released while reading */
+asynStatus drvTimRx::pollStatus()
 {
-    const char *functionName = "doExecuteHwWriteFunction<functionsInt32Chan_t>";
-    halcs_client_err_e err = HALCS_CLIENT_SUCCESS;
     int status = asynSuccess;
-    char serviceChanStr[SERVICE_NAME_SIZE];
-    int serviceID = 0;
-    epicsUInt32 serviceChan = addr;
+    asynStatus laneStatus = asynSuccess;
+    timRxSharedClient_t *sharedClient = NULL;
+    epicsTimeStamp startTime;
+    epicsTimeStamp endTime;
+    const int statusFuncs[] = {
+        P_TimRxLinkStatus,
+        P_TimRxRxenStatus,
+        P_TimRxRefClkLocked,
+        P_TimRxAlive
+    };
+    const size_t numFuncs = ARRAY_SIZE(statusFuncs);
+    pollRead_t reads[numFuncs];
+
+    epicsTimeGetCurrent(&startTime);
+    /* All parameters of the sweep share this timestamp */
+    updateTimeStamp();
+
+    for (size_t i = 0; i < numFuncs; ++i) {
+        reads[i].functionId = statusFuncs[i];
+        reads[i].addr = 0;
+    }
 
-    /* Execute registered function */
-    err = func.write(timRxClient, service, serviceChan, functionParam.argUInt32);
-    if (err != HALCS_CLIENT_SUCCESS) {
+    laneStatus = pollLaneBegin(&sharedClient);
+    pollReadBatch(sharedClient, laneStatus, reads, numFuncs);
+    pollLaneEnd(sharedClient);
+
+    for (size_t i = 0; i < numFuncs; ++i) {
+        if (reads[i].called) {
+            laneRecord(lanePoll, reads[i].wait, reads[i].depth);
+            hwAccessDone(reads[i].status, reads[i].err);
+        }
+        if (reads[i].status == asynSuccess) {
+            setUIntDigitalParam(statusFuncs[i], reads[i].value, 0xFFFFFFFF);
+        }
+        else {
+            status = reads[i].status;
+        }
+        /* Propagate read failures as alarms on the records */
+        setParamStatus(statusFuncs[i], reads[i].status);
+    }
+
+    epicsTimeGetCurrent(&endTime);
+    setDoubleParam(P_TimRxStatusPollTime, epicsTimeDiffInSeconds(&endTime, &startTime));
+
+    callParamCallbacks();
+
+    return (asynStatus)status;
+}
+
+/* Read the event counters of every AMC/FMC1/FMC2 trigger channel and
+ * publish them along with the accumulated totals and the trigger rates.
+ * Must be called with the driver lock held. The lock is released while
+ * reading */
+asynStatus drvTimRx::pollCounters()
+{
+    int status = asynSuccess;
+    asynStatus laneStatus = asynSuccess;
+    timRxSharedClient_t *sharedClient = NULL;
+    epicsTimeStamp startTime;
+    epicsTimeStamp endTime;
+    const cntFuncs_t cntFuncs[] = {
+        {P_TimRxAmcCnt, P_TimRxAmcCntTotal, P_TimRxAmcRate, P_TimRxAmcRateWindow,
+            MAX_AMC_TRIGGER_CH},
+        {P_TimRxFmc1Cnt, P_TimRxFmc1CntTotal, P_TimRxFmc1Rate, P_TimRxFmc1RateWindow,
+            MAX_FMC1_TRIGGER_CH},
+        {P_TimRxFmc2Cnt, P_TimRxFmc2CntTotal, P_TimRxFmc2Rate, P_TimRxFmc2RateWindow,
+            MAX_FMC2_TRIGGER_CH}
+    };
+    const size_t numReads = MAX_TRIGGER_CH;
+    pollRead_t reads[numReads];
+    epicsUInt32 resetGens[numReads];
+    size_t n = 0;
+
+    epicsTimeGetCurrent(&startTime);
+    /* All counters of the sweep share this timestamp */
+    updateTimeStamp();
+
+    /* A reset written while the sweep reads leaves it unknown whether a
+     * value was read before or after it */
+    for (n = 0; n < numReads; ++n) {
+        resetGens[n] = cntState[n].resetGen;
+    }
+    n = 0;
+    for (size_t i = 0; i < ARRAY_SIZE(cntFuncs); ++i) {
+        for (int addr = 0; addr < cntFuncs[i].numChannels; ++addr, ++n) {
+            reads[n].functionId = cntFuncs[i].function;
+            reads[n].addr = addr;
+        }
+    }
+
+    laneStatus = pollLaneBegin(&sharedClient);
+    pollReadBatch(sharedClient, laneStatus, reads, numReads);
+    pollLaneEnd(sharedClient);
+
+    n = 0;
+    for (size_t i = 0; i < ARRAY_SIZE(cntFuncs); ++i) {
+        for (int addr = 0; addr < cntFuncs[i].numChannels; ++addr, ++n) {
+            const pollRead_t &read = reads[n];
+
+            if (read.called) {
+                laneRecord(lanePoll, read.wait, read.depth);
+                hwAccessDone(read.status, read.err);
+            }
+            if (read.status == asynSuccess) {
+                setUIntDigitalParam(addr, cntFuncs[i].function, read.value,
+                        0xFFFFFFFF);
+                if (resetGens[n] == cntState[n].resetGen) {
+                    updateCounter(cntFuncs[i], addr, &cntState[n], read.value,
+                            &read.time);
+                }
+            }
+            else {
+                status = read.status;
+            }
+            /* Propagate read failures as alarms on the records */
+            setParamStatus(addr, cntFuncs[i].function, read.status);
+            setParamStatus(addr, cntFuncs[i].totalFunction,
+                    (read.status == asynSuccess && !cntState[n].totalValid)?
+                    asynDisabled : read.status);
+            setParamStatus(addr, cntFuncs[i].rateFunction,
+                    (read.status == asynSuccess && !cntState[n].rateValid)?
+                    asynDisabled : read.status);
+        }
+    }
+
+    epicsTimeGetCurrent(&endTime);
+    setDoubleParam(P_TimRxCntPollTime, epicsTimeDiffInSeconds(&endTime, &startTime));
+
+    for (int addr = 0; addr < MAX_ADDR; ++addr) {
+        callParamCallbacks(addr);
+    }
+
+    return (asynStatus)status;
+}
+
+/* Fold a new counter sample into the accumulated total and the trigger
+ * rate of a channel. The 32-bit hardware counter is extended by adding
+ * its delta modulo 2^32, so wraps are counted. After a reset written by
+ * us the total restarts from the counter value. After a reconnection
+ * the hardware may have been reloaded, so a counter going backwards then
+ * is taken as restarted from 0 instead of wrapped.
+ *
+ * The rate of each interval is the counter delta over the time between
+ * the two reads, averaged exponentially with the channel window as the
+ * time constant. Must be called with the driver lock held */
+void drvTimRx::updateCounter(const cntFuncs_t &funcs, int addr, cntState_t *state,
+        epicsUInt32 cnt, const epicsTimeStamp *time)
+{
+    epicsUInt32 delta = 0;
+    epicsFloat64 window = 0.0;
+    epicsFloat64 dt = 0.0;
+    epicsFloat64 rate = 0.0;
+
+    if (state->resetSeen != state->resetGen) {
+        state->resetSeen = state->resetGen;
+        state->total = cnt;
+        state->totalValid = true;
+        goto store_sample;
+    }
+
+    if (!state->totalValid) {
+        state->total = cnt;
+        state->totalValid = true;
+        goto store_sample;
+    }
+
+    if (!state->valid) {
+        state->total += (cnt >= state->lastCnt)? cnt - state->lastCnt : cnt;
+        goto store_sample;
+    }
+
+    delta = cnt - state->lastCnt;
+    state->total += delta;
+
+    dt = epicsTimeDiffInSeconds(time, &state->lastTime);
+    /* The wall clock stepped back */
+    if (dt <= 0.0) {
+        goto store_sample;
+    }
+
+    rate = delta/dt;
+    getDoubleParam(addr, funcs.windowFunction, &window);
+    if (state->rateValid && window > 0.0) {
+        rate = state->rate + (rate - state->rate)*(1.0 - exp(-dt/window));
+    }
+
+    state->rate = rate;
+    state->rateValid = true;
+    setDoubleParam(addr, funcs.rateFunction, rate);
+
+store_sample:
+    state->valid = true;
+    state->lastCnt = cnt;
+    state->lastTime = *time;
+    setInteger64Param(addr, funcs.totalFunction, (epicsInt64)state->total);
+}
+
+/* Return the event counter state of the channel of a counter reset
+ * function, or NULL if rstFunction is not one */
+cntState_t *drvTimRx::getCntState(int rstFunction, int addr)
+{
+    if (rstFunction == P_TimRxAmcCntRst) {
+        return &cntState[addr];
+    }
+    if (rstFunction == P_TimRxFmc1CntRst) {
+        return &cntState[MAX_AMC_TRIGGER_CH + addr];
+    }
+    if (rstFunction == P_TimRxFmc2CntRst) {
+        return &cntState[MAX_AMC_TRIGGER_CH + MAX_FMC1_TRIGGER_CH + addr];
+    }
+
+    return NULL;
+}
+
+/* Bin of a time in the histograms of TIM_RX_HIST_NUM_BINS bins, see
+ * laneStats_t */
+static int timRxHistBin(epicsFloat64 time)
+{
+    epicsFloat64 bound = TIM_RX_HIST_WAIT_BASE;
+    int bin = 0;
+
+    while (bin < TIM_RX_HIST_NUM_BINS-1 && time >= bound) {
+        bound *= 2;
+        ++bin;
+    }
+
+    return bin;
+}
+
+/* Account one request of an execution lane. Must be called with the
+ * driver lock held */
+void drvTimRx::laneRecord(int lane, epicsFloat64 wait, int depth)
+{
+    laneStats_t &stats = laneStats[lane];
+    int bin = 0;
+
+    ++stats.waitHist[timRxHistBin(wait)];
+
+    bin = (depth < TIM_RX_HIST_NUM_BINS-1)? depth : TIM_RX_HIST_NUM_BINS-1;
+    ++stats.depthHist[bin];
+}
+
+/* Must be called with the driver lock held */
+void drvTimRx::publishLaneStats()
+{
+    doCallbacksInt32Array(laneStats[lanePort].waitHist, TIM_RX_HIST_NUM_BINS,
+            P_TimRxPortLaneWaitHist, 0);
+    doCallbacksInt32Array(laneStats[lanePort].depthHist, TIM_RX_HIST_NUM_BINS,
+            P_TimRxPortLaneDepthHist, 0);
+    doCallbacksInt32Array(laneStats[lanePoll].waitHist, TIM_RX_HIST_NUM_BINS,
+            P_TimRxPollLaneWaitHist, 0);
+    doCallbacksInt32Array(laneStats[lanePoll].depthHist, TIM_RX_HIST_NUM_BINS,
+            P_TimRxPollLaneDepthHist, 0);
+}
+
+/* Record one hardware access in the trace ring. Lock-free, so it can be
+ * called from any thread with or without the driver lock. Readers skip
+ * entries being written, or overwritten by a newer access */
+void drvTimRx::traceRecord(int functionId, int addr, int write, int lane,
+        const functionsArgs_t &value, const epicsTimeStamp *start,
+        const epicsTimeStamp *end, int err)
+{
+    size_t n = epicsAtomicIncrSizeT(&traceHead) - 1;
+    traceEntry_t *entry = &traceRing[n & (TIM_RX_TRACE_SIZE-1)];
+
+    epicsAtomicSetSizeT(&entry->seq, 0);
+    epicsAtomicWriteMemoryBarrier();
+
+    entry->functionId = functionId;
+    entry->addr = addr;
+    entry->write = write;
+    entry->lane = lane;
+    entry->value = value;
+    entry->start = *start;
+    entry->end = *end;
+    entry->err = err;
+
+    epicsAtomicWriteMemoryBarrier();
+    epicsAtomicSetSizeT(&entry->seq, n + 1);
+
+    latRecord(functionId, write? latOpWrite : latOpRead,
+            epicsTimeDiffInSeconds(end, start), err);
+}
+
+/* Copy trace entry number n. Fails if it was overwritten or is still
+ * being written */
+bool drvTimRx::traceGet(size_t n, traceEntry_t *entry) const
+{
+    const traceEntry_t *slot = &traceRing[n & (TIM_RX_TRACE_SIZE-1)];
+
+    if (epicsAtomicGetSizeT(&slot->seq) != n + 1) {
+        return false;
+    }
+
+    epicsAtomicReadMemoryBarrier();
+    *entry = *slot;
+    epicsAtomicReadMemoryBarrier();
+
+    return (epicsAtomicGetSizeT(&slot->seq) == n + 1);
+}
+
+/* Copy the complete entries among the last num ones, oldest first */
+void drvTimRx::traceSnapshot(size_t num, std::vector<traceEntry_t> &entries) const
+{
+    size_t head = epicsAtomicGetSizeT(&traceHead);
+    size_t first = 0;
+    traceEntry_t entry;
+
+    if (num > TIM_RX_TRACE_SIZE) {
+        num = TIM_RX_TRACE_SIZE;
+    }
+    first = (head > num)? head - num : 0;
+
+    entries.clear();
+    entries.reserve(head - first);
+    for (size_t n = first; n < head; ++n) {
+        if (traceGet(n, &entry)) {
+            entries.push_back(entry);
+        }
+    }
+}
+
+/* Publish the last num trace entries on the trace waveform, as
+ * TIM_RX_TRACE_DUMP_WORDS words each: access number, functionId, addr,
+ * write flag, lane, value (Float64 registers rounded), start seconds
+ * past the EPICS epoch and nanoseconds, and duration in nanoseconds.
+ * The HALCS error of failed accesses replaces the write flag, negated.
+ * Must be called with the driver lock held */
+void drvTimRx::publishTrace(epicsUInt32 num)
+{
+    std::vector<traceEntry_t> entries;
+    std::vector<epicsInt32> words;
+    const functionsHw_t *func = NULL;
+
+    traceSnapshot(num, entries);
+
+    words.reserve(entries.size()*TIM_RX_TRACE_DUMP_WORDS);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const traceEntry_t &entry = entries[i];
+
+        func = getHwFunc(entry.functionId);
+        words.push_back((epicsInt32) (entry.seq - 1));
+        words.push_back(entry.functionId);
+        words.push_back(entry.addr);
+        words.push_back((entry.err != HALCS_CLIENT_SUCCESS)? -entry.err : entry.write);
+        words.push_back(entry.lane);
+        if (func != NULL && func->type == functionsHwFloat64) {
+            words.push_back((epicsInt32) floor(entry.value.argFloat64 + 0.5));
+        }
+        else {
+            words.push_back((epicsInt32) entry.value.argUInt32);
+        }
+        words.push_back((epicsInt32) entry.start.secPastEpoch);
+        words.push_back((epicsInt32) entry.start.nsec);
+        words.push_back((epicsInt32) (epicsTimeDiffInSeconds(&entry.end, &entry.start)*1e9));
+    }
+
+    doCallbacksInt32Array(words.empty()? NULL : &words[0], words.size(),
+            P_TimRxTraceBuf, 0);
+}
+
+void drvTimRx::initLatParams()
+{
+    const latParams_t params[latNumOps] = {
+        {P_TimRxReadLatHist, P_TimRxReadLatP50, P_TimRxReadLatP99,
+            P_TimRxReadLatMax, P_TimRxReadLatErrors, P_TimRxReadLatTimeouts},
+        {P_TimRxWriteLatHist, P_TimRxWriteLatP50, P_TimRxWriteLatP99,
+            P_TimRxWriteLatMax, P_TimRxWriteLatErrors, P_TimRxWriteLatTimeouts},
+        {P_TimRxSi57xLatHist, P_TimRxSi57xLatP50, P_TimRxSi57xLatP99,
+            P_TimRxSi57xLatMax, P_TimRxSi57xLatErrors, P_TimRxSi57xLatTimeouts}
+    };
+
+    for (int i = 0; i < latNumOps; ++i) {
+        latParams[i] = params[i];
+    }
+
+    latStats.assign(NUM_PARAMS*latNumOps, latStats_t());
+}
+
+/* Account one HALCS call. Lock-free and allocation-free, so it can be
+ * called from any thread with or without the driver lock */
+void drvTimRx::latRecord(int functionId, int op, epicsFloat64 time, int err)
+{
+    latStats_t &stats = latStats[(functionId - FIRST_COMMAND)*latNumOps + op];
+    /* Calls over 2 s are accounted as 2 s in maxNs */
+    int ns = (time < 2.0)? (int) (time*1e9) : 2000000000;
+    int maxNs = 0;
+    int prevNs = 0;
+
+    epicsAtomicIncrIntT(&stats.hist[timRxHistBin(time)]);
+
+    if (err != HALCS_CLIENT_SUCCESS) {
+        epicsAtomicIncrIntT(&stats.errors);
+        if (err == HALCS_CLIENT_ERR_TIMEOUT) {
+            epicsAtomicIncrIntT(&stats.timeouts);
+        }
+    }
+
+    maxNs = epicsAtomicGetIntT(&stats.maxNs);
+    while (ns > maxNs) {
+        prevNs = epicsAtomicCmpAndSwapIntT(&stats.maxNs, maxNs, ns);
+        if (prevNs == maxNs) {
+            break;
+        }
+        maxNs = prevNs;
+    }
+}
+
+/* Add up the latencies of one operation, over one function or over all
+ * of them if functionId is negative */
+void drvTimRx::latSum(int op, int functionId, latStats_t *sum) const
+{
+    int first = (functionId < 0)? 0 : functionId - FIRST_COMMAND;
+    int last = (functionId < 0)? NUM_PARAMS-1 : first;
+    int maxNs = 0;
+
+    memset(sum, 0, sizeof(*sum));
+    for (int i = first; i <= last; ++i) {
+        const latStats_t &stats = latStats[i*latNumOps + op];
+
+        for (int bin = 0; bin < TIM_RX_HIST_NUM_BINS; ++bin) {
+            sum->hist[bin] += epicsAtomicGetIntT(&stats.hist[bin]);
+        }
+        sum->errors += epicsAtomicGetIntT(&stats.errors);
+        sum->timeouts += epicsAtomicGetIntT(&stats.timeouts);
+        maxNs = epicsAtomicGetIntT(&stats.maxNs);
+        if (maxNs > sum->maxNs) {
+            sum->maxNs = maxNs;
+        }
+    }
+}
+
+/* Latency below which the given fraction of the calls fall, in seconds.
+ * Resolved to the upper bound of a histogram bin, but never above the
+ * longest call */
+epicsFloat64 drvTimRx::latPercentile(const latStats_t &stats, epicsFloat64 fraction) const
+{
+    epicsFloat64 max = stats.maxNs*1e-9;
+    epicsFloat64 bound = TIM_RX_HIST_WAIT_BASE;
+    epicsFloat64 count = 0.0;
+    epicsFloat64 total = 0.0;
+
+    for (int bin = 0; bin < TIM_RX_HIST_NUM_BINS; ++bin) {
+        total += stats.hist[bin];
+    }
+
+    if (total == 0.0) {
+        return 0.0;
+    }
+
+    for (int bin = 0; bin < TIM_RX_HIST_NUM_BINS-1; ++bin) {
+        count += stats.hist[bin];
+        if (count >= fraction*total) {
+            return (bound < max)? bound : max;
+        }
+        bound *= 2;
+    }
+
+    return max;
+}
+
+/* Calls in progress may still be accounted after the reset */
+void drvTimRx::resetLatStats()
+{
+    for (size_t i = 0; i < latStats.size(); ++i) {
+        for (int bin = 0; bin < TIM_RX_HIST_NUM_BINS; ++bin) {
+            epicsAtomicSetIntT(&latStats[i].hist[bin], 0);
+        }
+        epicsAtomicSetIntT(&latStats[i].errors, 0);
+        epicsAtomicSetIntT(&latStats[i].timeouts, 0);
+        epicsAtomicSetIntT(&latStats[i].maxNs, 0);
+    }
+}
+
+/* Publish the latencies of each operation over all functions. Must be
+ * called with the driver lock held */
+void drvTimRx::publishLatStats()
+{
+    latStats_t sum;
+
+    for (int op = 0; op < latNumOps; ++op) {
+        latSum(op, -1, &sum);
+        doCallbacksInt32Array(sum.hist, TIM_RX_HIST_NUM_BINS, latParams[op].hist, 0);
+        setDoubleParam(latParams[op].p50, latPercentile(sum, 0.5));
+        setDoubleParam(latParams[op].p99, latPercentile(sum, 0.99));
+        setDoubleParam(latParams[op].max, sum.maxNs*1e-9);
+        setUIntDigitalParam(latParams[op].errors, sum.errors, 0xFFFFFFFF);
+        setUIntDigitalParam(latParams[op].timeouts, sum.timeouts, 0xFFFFFFFF);
+    }
+}
+
+/* Add the HALCS call latencies to the port report. details 1 prints them
+ * by operation, 2 or more by function as well */
+void drvTimRx::report(FILE *fp, int details)
+{
+    static const char *opNames[latNumOps] = {"read", "write", "si57x"};
+    latStats_t sum;
+    int calls = 0;
+
+    asynPortDriver::report(fp, details);
+
+    if (details < 1) {
+        return;
+    }
+
+    fprintf(fp, "  HALCS call latencies, us:\n");
+    fprintf(fp, "    %-32s %-5s %10s %10s %10s %10s %8s %8s\n", "function", "op",
+            "calls", "p50", "p99", "max", "errors", "timeouts");
+    for (int op = 0; op < latNumOps; ++op) {
+        latSum(op, -1, &sum);
+        calls = 0;
+        for (int bin = 0; bin < TIM_RX_HIST_NUM_BINS; ++bin) {
+            calls += sum.hist[bin];
+        }
+        fprintf(fp, "    %-32s %-5s %10d %10.1f %10.1f %10.1f %8d %8d\n", "all",
+                opNames[op], calls, latPercentile(sum, 0.5)*1e6,
+                latPercentile(sum, 0.99)*1e6, sum.maxNs*1e-3, sum.errors,
+                sum.timeouts);
+    }
+
+    if (details < 2) {
+        return;
+    }
+
+    for (int functionId = FIRST_COMMAND; functionId <= LAST_COMMAND; ++functionId) {
+        for (int op = 0; op < latNumOps; ++op) {
+            latSum(op, functionId, &sum);
+            calls = 0;
+            for (int bin = 0; bin < TIM_RX_HIST_NUM_BINS; ++bin) {
+                calls += sum.hist[bin];
+            }
+            if (calls == 0) {
+                continue;
+            }
+            fprintf(fp, "    %-32s %-5s %10d %10.1f %10.1f %10.1f %8d %8d\n",
+                    timRxParams[functionId - FIRST_COMMAND].name, opNames[op],
+                    calls, latPercentile(sum, 0.5)*1e6,
+                    latPercentile(sum, 0.99)*1e6, sum.maxNs*1e-3, sum.errors,
+                    sum.timeouts);
+        }
+    }
+}
+
+/* Print the last num trace entries. Reads the ring with no lock, so the
+ * traced accesses are not held up */
+void drvTimRx::dumpTrace(int num) const
+{
+    std::vector<traceEntry_t> entries;
+    const functionsHw_t *func = NULL;
+    char timeStr[40];
+    char laneStr[16];
+    char valueStr[32];
+
+    traceSnapshot((num > 0)? num : 0, entries);
+
+    printf("%s: last %u of %lu hardware accesses\n", timRxPortName,
+            (unsigned) entries.size(), (unsigned long) epicsAtomicGetSizeT(&traceHead));
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const traceEntry_t &entry = entries[i];
+
+        func = getHwFunc(entry.functionId);
+        epicsTimeToStrftime(timeStr, sizeof(timeStr), "%H:%M:%S.%06f", &entry.start);
+        if (entry.lane < numLanes) {
+            epicsSnprintf(laneStr, sizeof(laneStr), "%s",
+                    (entry.lane == lanePoll)? "poll" : "port");
+        }
+        else {
+            epicsSnprintf(laneStr, sizeof(laneStr), "worker%d", entry.lane - numLanes);
+        }
+        if (func != NULL && func->type == functionsHwFloat64) {
+            epicsSnprintf(valueStr, sizeof(valueStr), "%f", entry.value.argFloat64);
+        }
+        else {
+            epicsSnprintf(valueStr, sizeof(valueStr), "0x%08x", entry.value.argUInt32);
+        }
+
+        printf("%10lu %s %9.1f us %-8s %s %-32s %d %s",
+                (unsigned long) (entry.seq - 1), timeStr,
+                epicsTimeDiffInSeconds(&entry.end, &entry.start)*1e6, laneStr,
+                entry.write? "W" : "R",
+                timRxParams[entry.functionId - FIRST_COMMAND].name, entry.addr,
+                valueStr);
+        if (entry.err != HALCS_CLIENT_SUCCESS) {
+            printf(" error %d (%s)", entry.err,
+                    halcs_client_err_str((halcs_client_err_e) entry.err));
+        }
+        printf("\n");
+    }
+}
+
+asynStatus drvTimRx::startFlushTask()
+{
+    const char *functionName = "startFlushTask";
+    char threadName[32];
+    int started = 0;
+
+    epicsThreadOnce(&timRxOnceId, timRxOnceC, NULL);
+
+    pendingWrites.assign(NUM_PARAMS*MAX_ADDR, pendingWrite_t());
+
+    flushTaskExit = false;
+    pollReadDoneEvent = epicsEventMustCreate(epicsEventEmpty);
+    /* Sized once, the threads keep pointers to their worker */
+    flushWorkers.resize(numWorkers);
+    for (int i = 0; i < numWorkers; ++i) {
+        flushWorkers[i].driver = this;
+        flushWorkers[i].index = i;
+        flushWorkers[i].pendingWriteList.reserve(NUM_PARAMS*MAX_ADDR);
+        flushWorkers[i].event = epicsEventMustCreate(epicsEventEmpty);
+        flushWorkers[i].doneEvent = epicsEventMustCreate(epicsEventEmpty);
+    }
+
+    for (started = 0; started < numWorkers; ++started) {
+        epicsSnprintf(threadName, sizeof(threadName), "drvTimRxFlush%d", started);
+        if (epicsThreadCreate(threadName, epicsThreadPriorityMedium,
+                    epicsThreadGetStackSize(epicsThreadStackMedium),
+                    (EPICSTHREADFUNC)flushTaskC, &flushWorkers[started]) == NULL) {
+            asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
+                "%s:%s: epicsThreadCreate failure\n",
+                driverName, functionName);
+            goto create_thread_err;
+        }
+    }
+
+    return asynSuccess;
+
+create_thread_err:
+    /* Nothing can be queued yet, so the workers already started exit
+     * right away */
+    lock();
+    flushTaskExit = true;
+    unlock();
+    for (int i = 0; i < started; ++i) {
+        epicsEventSignal(flushWorkers[i].event);
+        epicsEventWait(flushWorkers[i].doneEvent);
+    }
+    for (int i = 0; i < numWorkers; ++i) {
+        epicsEventDestroy(flushWorkers[i].event);
+        epicsEventDestroy(flushWorkers[i].doneEvent);
+    }
+    flushWorkers.clear();
+    epicsEventDestroy(pollReadDoneEvent);
+    pollReadDoneEvent = NULL;
+    return asynError;
+}
+
+/* Stop the flush threads. Writes still held are flushed before they exit */
+void drvTimRx::stopFlushTask()
+{
+    if (flushWorkers.empty()) {
+        return;
+    }
+
+    lock();
+    flushTaskExit = true;
+    unlock();
+    for (size_t i = 0; i < flushWorkers.size(); ++i) {
+        epicsEventSignal(flushWorkers[i].event);
+        epicsEventWait(flushWorkers[i].doneEvent);
+    }
+
+    for (size_t i = 0; i < flushWorkers.size(); ++i) {
+        epicsEventDestroy(flushWorkers[i].event);
+        epicsEventDestroy(flushWorkers[i].doneEvent);
+    }
+    flushWorkers.clear();
+    epicsEventDestroy(pollReadDoneEvent);
+    pollReadDoneEvent = NULL;
+}
+
+/* Must be called with the driver lock held */
+void drvTimRx::resetFlushStats()
+{
+    flushLatencyMax = 0.0;
+    flushLatencySum = 0.0;
+    flushLatencies = 0;
+    setDoubleParam(P_TimRxWriteFlushLatencyMax, 0.0);
+    setDoubleParam(P_TimRxWriteFlushLatencyAvg, 0.0);
+}
+
+/* Wake every flush thread up, so held writes are reevaluated, and sweep
+ * reads picked up */
+void drvTimRx::signalFlushWorkers()
+{
+    for (size_t i = 0; i < flushWorkers.size(); ++i) {
+        epicsEventSignal(flushWorkers[i].event);
+    }
+}
+
+/* Hold a write to the given parameter in the coalescing stage, if the
+ * parameter allows it or it is a partial write (Si57x registers excepted,
+ * as their shadow follows each write), and a holdoff is set. The value to
+ * be written is the one in the parameter library when the write is
+ * flushed, so a write already pending for (functionId, addr) is
+ * superseded, or merged with if both are partial. Each register belongs
+ * to the worker of its stripe, so its writes stay in order. Returns false
+ * if the write must go straight to hardware. Must be called with the
+ * driver lock held */
+bool drvTimRx::queueWrite(int functionId, epicsUInt32 mask, int addr)
+{
+    epicsFloat64 holdoff = 0.0;
+    int slot = (functionId - FIRST_COMMAND)*MAX_ADDR + addr;
+    bool partial = (mask != 0xFFFFFFFF && getHwFunc(functionId) != NULL &&
+            getSi57xOsc(functionId) < 0);
+
+    if (!(getParamFlags(functionId) & TIM_RX_PARAM_COALESCE) && !partial) {
+        return false;
+    }
+
+    if (flushWorkers.empty()) {
+        return false;
+    }
+
+    /* A held write completes its record before reaching hardware, and a
+     * failed write can then only be seen in the parameter status. Writes
+     * are only held when coalescing is asked for with a holdoff, without
+     * one the record gets the outcome of the write */
+    getDoubleParam(P_TimRxWriteHoldoff, &holdoff);
+    if (holdoff <= 0.0) {
+        return false;
+    }
+
+    pendingWrite_t &pendingWrite = pendingWrites[slot];
+    if (pendingWrite.pending) {
+        pendingWrite.mask |= mask;
+        ++writeCoalesced;
+        setUIntDigitalParam(P_TimRxWriteCoalesced, writeCoalesced, 0xFFFFFFFF);
+        return true;
+    }
+
+    pendingWrite.pending = true;
+    pendingWrite.mask = mask;
+    epicsTimeGetCurrent(&pendingWrite.queued);
+    flushWorker_t &worker = flushWorkers[(slot % TIM_RX_REG_LOCK_STRIPES) % numWorkers];
+    worker.pendingWriteList.push_back(slot);
+    epicsEventSignal(worker.event);
+
+    return true;
+}
+
+/* Write to hardware the held writes of a worker older than holdoff, or all
+ * of them if force is set. The outcome is reported with the parameter
+ * status and callbacks, as the record that requested the write has
+ * already completed: asyn device support completes a record when the
+ * driver call returns, so a held write cannot complete it later. Returns the time until the next held write is due, or
+ * a negative value if none is held. Must be called with the driver lock
+ * held, from the worker thread */
+epicsFloat64 drvTimRx::flushWrites(flushWorker_t *worker, const epicsTimeStamp *now,
+        epicsFloat64 holdoff, bool force)
+{
+    asynStatus status = asynSuccess;
+    epicsFloat64 wait = -1.0;
+    epicsFloat64 age = 0.0;
+    epicsTimeStamp doneTime;
+    epicsFloat64 latency = 0.0;
+    bool flushed = false;
+    size_t i = 0;
+
+    std::vector<int> &pendingWriteList = worker->pendingWriteList;
+
+    while (i < pendingWriteList.size()) {
+        int slot = pendingWriteList[i];
+        int functionId = FIRST_COMMAND + slot/MAX_ADDR;
+        int addr = slot%MAX_ADDR;
+        pendingWrite_t &pendingWrite = pendingWrites[slot];
+
+        age = epicsTimeDiffInSeconds(now, &pendingWrite.queued);
+        if (!force && age < holdoff) {
+            if (wait < 0.0 || holdoff - age < wait) {
+                wait = holdoff - age;
+            }
+            ++i;
+            continue;
+        }
+
+        pendingWriteList.erase(pendingWriteList.begin() + i);
+        pendingWrite.pending = false;
+
+        status = setParam32(functionId, pendingWrite.mask, addr);
+        epicsTimeGetCurrent(&doneTime);
+        latency = epicsTimeDiffInSeconds(&doneTime, &pendingWrite.queued);
+        if (latency > flushLatencyMax) {
+            flushLatencyMax = latency;
+        }
+        flushLatencySum += latency;
+        ++flushLatencies;
+        setDoubleParam(P_TimRxWriteFlushLatency, latency);
+        setDoubleParam(P_TimRxWriteFlushLatencyMax, flushLatencyMax);
+        setDoubleParam(P_TimRxWriteFlushLatencyAvg, flushLatencySum/flushLatencies);
+        setParamStatus(addr, functionId, status);
+        callParamCallbacks(addr);
+        flushed = true;
+    }
+
+    if (flushed) {
+        callParamCallbacks();
+    }
+
+    return wait;
+}
+
+/** Write coalescing flush thread, one per worker. Sleeps until the oldest
+ * held write of the worker is due and flushes it together with any other
+ * one that is due */
+void drvTimRx::flushTask(flushWorker_t *worker)
+{
+    epicsFloat64 holdoff = 0.0;
+    epicsFloat64 wait = -1.0;
+    epicsTimeStamp now;
+
+    /* Lets beginHwAccess pick the worker client */
+    epicsThreadPrivateSet(timRxWorkerPvt, worker);
+
+    lock();
+    while (!flushTaskExit) {
+        runPollReads(worker);
+        getDoubleParam(P_TimRxWriteHoldoff, &holdoff);
+        epicsTimeGetCurrent(&now);
+        wait = flushWrites(worker, &now, holdoff, false);
+        unlock();
+
+        if (wait < 0.0) {
+            epicsEventWait(worker->event);
+        }
+        else {
+            epicsEventWaitWithTimeout(worker->event, wait);
+        }
+
+        lock();
+    }
+
+    /* Do not drop held writes, nor leave a sweep waiting */
+    runPollReads(worker);
+    epicsTimeGetCurrent(&now);
+    flushWrites(worker, &now, 0.0, true);
+    unlock();
+
+    epicsEventSignal(worker->doneEvent);
+}
+
+/* The client is opened by the connection manager, so asynManager
+ * connection requests do not block the port waiting for HALCS */
+asynStatus drvTimRx::connect(asynUser* pasynUser)
+{
+    if (timRxSharedClient == NULL) {
+        if (connEvent != NULL) {
+            epicsEventSignal(connEvent);
+        }
+        return asynError;
+    }
+
+    pasynManager->exceptionConnect(pasynUser);
+    return asynSuccess;
+}
+
+/* Start using sharedClient, which the caller acquired and found
+ * answering without the driver lock. The client is shared with the other
+ * receiver of the board, if it is served by this IOC as well. Must be
+ * called with the driver lock held */
+asynStatus drvTimRx::timRxClientConnect(asynUser* pasynUser,
+        timRxSharedClient_t *sharedClient)
+{
+    const char *functionName = "timRxClientConnect";
+
+    if (timRxSharedClient == NULL) {
+        timRxSharedClientRef(sharedClient);
+        timRxSharedClient = sharedClient;
+        timRxClient = timRxSharedClient->client;
+        /* Registers may have changed while we were away */
+        invalidateRegShadow();
+        for (size_t i = 0; i < ARRAY_SIZE(cntState); ++i) {
+            cntState[i].valid = false;
+        }
+    }
+
+    asynPrint(this->pasynUserSelf, ASYN_TRACE_FLOW,
+        "%s:%s: Tim Rx client connected\n",
+        driverName, functionName);
+
+    pasynManager->exceptionConnect(pasynUser);
+
+    return asynSuccess;
+}
+
+asynStatus drvTimRx::disconnect(asynUser* pasynUser)
+{
+    return timRxClientDisconnect(pasynUser);
+}
+
+asynStatus drvTimRx::timRxClientDisconnect(asynUser* pasynUser)
+{
+    asynPrint(this->pasynUserSelf, ASYN_TRACE_FLOW,
+            "%s: calling timRxClientDisconnect\n",
+            driverName);
+    asynStatus status = asynSuccess;
+
+    if (timRxSharedClient != NULL) {
+        timRxSharedClientRelease(timRxSharedClient);
+        timRxSharedClient = NULL;
+        timRxClient = NULL;
+    }
+
+    pasynManager->exceptionDisconnect(pasynUser);
+    return status;
+}
+
+/* Serialize calls on the HALCS client with the other receiver of the
+ * board. Every HALCS call must be done between lockClient and unlockClient.
+ * Fails while the client is missing or the circuit breaker is open */
+asynStatus drvTimRx::lockClient()
+{
+    if (timRxSharedClient == NULL) {
+        return asynDisconnected;
+    }
+
+    if (breakerState != breakerClosed) {
+        return asynTimeout;
+    }
+
+    epicsTimeStamp startTime;
+    epicsTimeStamp endTime;
+    int depth = 0;
+
+    epicsTimeGetCurrent(&startTime);
+    depth = epicsAtomicIncrIntT(&timRxSharedClient->lockWaiters) - 1;
+    epicsMutexMustLock(timRxSharedClient->lock);
+    epicsAtomicDecrIntT(&timRxSharedClient->lockWaiters);
+    epicsTimeGetCurrent(&endTime);
+    ++clientHoldDepth;
+
+    laneRecord(lanePort, epicsTimeDiffInSeconds(&endTime, &startTime), depth);
+
+    return asynSuccess;
+}
+
+void drvTimRx::unlockClient()
+{
+    --clientHoldDepth;
+    epicsMutexUnlock(timRxSharedClient->lock);
+}
+
+/* Whether every earlier HALCS call on slot is done */
+bool drvTimRx::regTurnReady(int slot, int ticket) const
+{
+    return epicsAtomicGetIntT(&regIoDone[slot]) == ticket - 1;
+}
+
+/* Wait until every earlier HALCS call on slot is done. The call with the
+ * previous ticket wakes us up, see regTurnDone. Must be called without
+ * the driver lock nor any client lock held, as the calls waited for may
+ * need them */
+void drvTimRx::waitRegTurn(int slot, int ticket)
+{
+    int stripe = slot % TIM_RX_REG_LOCK_STRIPES;
+    std::vector<regTurnWaiter_t *> &waiters = regTurnWaiters[stripe];
+    regTurnWaiter_t waiter;
+
+    if (regTurnReady(slot, ticket)) {
+        return;
+    }
+
+    waiter.slot = slot;
+    waiter.ticket = ticket;
+    waiter.event = (epicsEventId) epicsThreadPrivateGet(timRxTurnEventPvt);
+    if (waiter.event == NULL) {
+        waiter.event = epicsEventMustCreate(epicsEventEmpty);
+        epicsThreadPrivateSet(timRxTurnEventPvt, waiter.event);
+    }
+
+    epicsMutexMustLock(regLocks[stripe]);
+    waiters.push_back(&waiter);
+    while (!regTurnReady(slot, ticket)) {
+        epicsMutexUnlock(regLocks[stripe]);
+        epicsEventMustWait(waiter.event);
+        epicsMutexMustLock(regLocks[stripe]);
+    }
+    for (size_t i = 0; i < waiters.size(); ++i) {
+        if (waiters[i] == &waiter) {
+            waiters.erase(waiters.begin() + i);
+            break;
+        }
+    }
+    epicsMutexUnlock(regLocks[stripe]);
+}
+
+/* Start one HALCS call on (functionId, addr). Unless the thread already
+ * holds the client, or HwUnlock is off, the driver lock is released
+ * until endHwAccess, so callbacks and other requests do not wait for the
+ * broker. Calls on one register reach the broker in the order they were
+ * issued: each takes a ticket from regIoSeq with the driver lock held
+ * and waits, with the driver lock released, until the call with the
+ * previous ticket is done. This holds with HwUnlock off as well, the
+ * driver lock is then taken again for the call. Write workers call
+ * through their own client, the other threads through the port lane
+ * client. Nothing waits for the driver lock while holding a stripe or
+ * client lock. Must be called with the driver lock held */
+asynStatus drvTimRx::beginHwAccess(int functionId, int addr, hwAccess_t *access)
+{
+    asynStatus status = asynSuccess;
+    epicsUInt32 hwUnlock = 0;
+    epicsTimeStamp startTime;
+    epicsTimeStamp endTime;
+    timRxSharedClient_t *sharedClient = NULL;
+    flushWorker_t *worker = NULL;
+
+    access->unlocked = false;
+    access->slot = (functionId - FIRST_COMMAND)*MAX_ADDR + addr;
+    access->ioSeq = 0;
+    access->lane = lanePort;
+    access->called = false;
+    access->err = HALCS_CLIENT_SUCCESS;
+    access->sharedClient = NULL;
+    access->client = NULL;
+    access->clientLock = NULL;
+    access->clientLockWaiters = NULL;
+    access->stripe = NULL;
+
+    /* Nested in a lockClient hold: the client lock orders the call, and
+     * waiting for a turn here could wait for a call needing that lock */
+    if (clientHoldDepth > 0 || regIoSeq.empty()) {
+        status = lockClient();
+        if (status == asynSuccess) {
+            access->client = timRxClient;
+            if (!regIoSeq.empty()) {
+                access->ioSeq = epicsAtomicGetIntT(&regIoSeq[access->slot]);
+            }
+        }
+        return status;
+    }
+
+    getUIntDigitalParam(P_TimRxHwUnlock, &hwUnlock, 0xFFFFFFFF);
+    if (!hwUnlock) {
+        access->ioSeq = epicsAtomicIncrIntT(&regIoSeq[access->slot]);
+        access->stripe = regLocks[access->slot % TIM_RX_REG_LOCK_STRIPES];
+        if (!regTurnReady(access->slot, access->ioSeq)) {
+            unlock();
+            waitRegTurn(access->slot, access->ioSeq);
+            lock();
+        }
+        /* The client may have gone while the driver lock was released */
+        status = lockClient();
+        if (status != asynSuccess) {
+            regTurnDone(access);
+            return status;
+        }
+        access->client = timRxClient;
+        return asynSuccess;
+    }
+
+    if (timRxSharedClient == NULL) {
+        return asynDisconnected;
+    }
+
+    if (breakerState != breakerClosed) {
+        return asynTimeout;
+    }
+
+    /* Keep the client alive even if the connection manager drops it */
+    sharedClient = timRxSharedClient;
+    timRxSharedClientRef(sharedClient);
+    access->sharedClient = sharedClient;
+    access->client = sharedClient->client;
+    access->clientLock = sharedClient->lock;
+    access->clientLockWaiters = &sharedClient->lockWaiters;
+    worker = (flushWorker_t *) epicsThreadPrivateGet(timRxWorkerPvt);
+    if (worker != NULL && worker->driver == this &&
+            worker->index < epicsAtomicGetIntT(&sharedClient->numWorkers)) {
+        access->client = sharedClient->workerClients[worker->index];
+        access->clientLock = sharedClient->workerLocks[worker->index];
+        access->clientLockWaiters = &sharedClient->workerLockWaiters[worker->index];
+        access->lane = numLanes + worker->index;
+    }
+    access->stripe = regLocks[access->slot % TIM_RX_REG_LOCK_STRIPES];
+    access->unlocked = true;
+
+    access->ioSeq = epicsAtomicIncrIntT(&regIoSeq[access->slot]);
+    unlock();
+
+    epicsTimeGetCurrent(&startTime);
+    waitRegTurn(access->slot, access->ioSeq);
+    access->depth = epicsAtomicIncrIntT(access->clientLockWaiters) - 1;
+    epicsMutexMustLock(access->clientLock);
+    epicsAtomicDecrIntT(access->clientLockWaiters);
+    epicsTimeGetCurrent(&endTime);
+    access->wait = epicsTimeDiffInSeconds(&endTime, &startTime);
+
+    return asynSuccess;
+}
+
+/* Mark the call of access done on its register and wake up the call
+ * with the next ticket, if it is waiting */
+void drvTimRx::regTurnDone(hwAccess_t *access)
+{
+    int stripe = access->slot % TIM_RX_REG_LOCK_STRIPES;
+    std::vector<regTurnWaiter_t *> &waiters = regTurnWaiters[stripe];
+
+    epicsMutexMustLock(access->stripe);
+    epicsAtomicSetIntT(&regIoDone[access->slot], access->ioSeq);
+    for (size_t i = 0; i < waiters.size(); ++i) {
+        if (waiters[i]->slot == access->slot &&
+                waiters[i]->ticket == access->ioSeq + 1) {
+            epicsEventSignal(waiters[i]->event);
+            break;
+        }
+    }
+    epicsMutexUnlock(access->stripe);
+}
+
+/* Finish a HALCS call started by beginHwAccess. The driver lock is held
+ * again on return */
+void drvTimRx::endHwAccess(hwAccess_t *access)
+{
+    if (!access->unlocked) {
+        unlockClient();
+        if (access->stripe != NULL) {
+            regTurnDone(access);
+        }
+    }
+    else {
+        epicsMutexUnlock(access->clientLock);
+        regTurnDone(access);
+
+        lock();
+        laneRecord(lanePort, access->wait, access->depth);
+        timRxSharedClientRelease(access->sharedClient);
+    }
+
+    /* Let storeRegShadow order the result against other calls */
+    hwIoSlot = access->slot;
+    hwIoSeq = access->ioSeq;
+}
+
+asynStatus drvTimRx::lock()
+{
+    asynStatus status = asynPortDriver::lock();
+
+    if (lockDepth++ == 0) {
+        epicsTimeGetCurrent(&lockTaken);
+    }
+
+    return status;
+}
+
+asynStatus drvTimRx::unlock()
+{
+    epicsTimeStamp now;
+    epicsFloat64 hold = 0.0;
+
+    if (--lockDepth == 0) {
+        epicsTimeGetCurrent(&now);
+        hold = epicsTimeDiffInSeconds(&now, &lockTaken);
+        if (hold > lockHoldMax) {
+            lockHoldMax = hold;
+        }
+        lockHoldSum += hold;
+        ++lockHolds;
+    }
+
+    return asynPortDriver::unlock();
+}
+
+/* Must be called with the driver lock held */
+void drvTimRx::resetLockStats()
+{
+    lockHoldMax = 0.0;
+    lockHoldSum = 0.0;
+    lockHolds = 0;
+}
+
+/* Must be called with the driver lock held. The hold in progress is not
+ * accounted yet */
+void drvTimRx::publishLockStats()
+{
+    setDoubleParam(P_TimRxLockHoldMax, lockHoldMax);
+    setDoubleParam(P_TimRxLockHoldAvg, (lockHolds > 0)? lockHoldSum/lockHolds : 0.0);
+}
+
+/* Check a client reaches its board with a read of the alive register */
+asynStatus drvTimRx::probeClient(timRxSharedClient_t *sharedClient) const
+{
+    const functionsHw_t *func = getHwFunc(P_TimRxAlive);
+    char *service = getServiceName(P_TimRxAlive);
+    epicsUInt32 alive = 0;
+    halcs_client_err_e err = HALCS_CLIENT_SUCCESS;
+
+    if (func == NULL || service == NULL) {
+        return asynError;
+    }
+
+    epicsMutexMustLock(sharedClient->lock);
+    err = func->int32.read(sharedClient->client, service, &alive);
+    epicsMutexUnlock(sharedClient->lock);
+
+    return (err == HALCS_CLIENT_SUCCESS)? asynSuccess : asynDisconnected;
+}
+
+/* Number of consecutive HALCS timeouts that opens the breaker. Must be
+ * called with the driver lock held */
+epicsUInt32 drvTimRx::getBreakerThreshold()
+{
+    epicsUInt32 threshold = 0;
+
+    getUIntDigitalParam(P_TimRxBreakerThreshold, &threshold, 0xFFFFFFFF);
+    return (threshold > 0)? threshold : 1;
+}
+
+/* Circuit breaker bookkeeping after a HALCS call, with err the HALCS
+ * outcome. After TIM_RX_BREAKER_THRESHOLD consecutive timeouts, the
+ * breaker opens and HALCS calls fail right away instead of each one
+ * waiting out the client timeout. Any other outcome means the broker
+ * answered, so it does not count. The connection manager then probes the
+ * link and closes the breaker once it answers. Must be called with the
+ * driver lock held */
+void drvTimRx::hwAccessDone(asynStatus status, halcs_client_err_e err)
+{
+    if (status == asynSuccess || err != HALCS_CLIENT_ERR_TIMEOUT) {
+        breakerFailures = 0;
+        return;
+    }
+
+    if (++breakerFailures >= getBreakerThreshold() && breakerState == breakerClosed) {
+        asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
+            "%s:%s: %u consecutive HALCS timeouts, failing fast until %s answers\n",
+            driverName, "hwAccessDone", breakerFailures, endpoint);
+        ++breakerTrips;
+        setUIntDigitalParam(P_TimRxBreakerTrips, breakerTrips, 0xFFFFFFFF);
+        setBreakerState(breakerOpen);
+        callParamCallbacks();
+        if (connEvent != NULL) {
+            epicsEventSignal(connEvent);
+        }
+    }
+}
+
+/* Must be called with the driver lock held */
+void drvTimRx::setBreakerState(int state)
+{
+    epicsTimeStamp now;
+
+    if (state == breakerState) {
+        return;
+    }
+
+    epicsTimeGetCurrent(&now);
+    if (breakerState == breakerClosed) {
+        breakerOpenSince = now;
+    }
+    else if (state == breakerClosed) {
+        breakerOpenTotal += epicsTimeDiffInSeconds(&now, &breakerOpenSince);
+        breakerFailures = 0;
+    }
+
+    breakerState = state;
+    setUIntDigitalParam(P_TimRxBreakerState, breakerState, 0xFFFFFFFF);
+}
+
+/* Total seconds the breaker has been open, including the current period */
+asynStatus drvTimRx::getBreakerOpenTime(epicsFloat64 *value)
+{
+    epicsTimeStamp now;
+
+    *value = breakerOpenTotal;
+    if (breakerState != breakerClosed) {
+        epicsTimeGetCurrent(&now);
+        *value += epicsTimeDiffInSeconds(&now, &breakerOpenSince);
+    }
+    setDoubleParam(P_TimRxBreakerOpenTime, *value);
+
+    return asynSuccess;
+}
+
+asynStatus drvTimRx::startConnTask()
+{
+    const char *functionName = "startConnTask";
+
+    connTaskExit = false;
+    connEvent = epicsEventMustCreate(epicsEventEmpty);
+    connDoneEvent = epicsEventMustCreate(epicsEventEmpty);
+    connFirstEvent = epicsEventMustCreate(epicsEventEmpty);
+
+    if (epicsThreadCreate("drvTimRxConn", epicsThreadPriorityMedium,
+                epicsThreadGetStackSize(epicsThreadStackMedium),
+                (EPICSTHREADFUNC)connTaskC, this) == NULL) {
+        asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
+            "%s:%s: epicsThreadCreate failure\n",
+            driverName, functionName);
+        epicsEventDestroy(connEvent);
+        epicsEventDestroy(connDoneEvent);
+        epicsEventDestroy(connFirstEvent);
+        connEvent = NULL;
+        connDoneEvent = NULL;
+        connFirstEvent = NULL;
+        return asynError;
+    }
+
+    return asynSuccess;
+}
+
+void drvTimRx::stopConnTask()
+{
+    if (connEvent == NULL) {
+        return;
+    }
+
+    lock();
+    connTaskExit = true;
+    unlock();
+    epicsEventSignal(connEvent);
+    epicsEventWait(connDoneEvent);
+
+    epicsEventDestroy(connEvent);
+    epicsEventDestroy(connDoneEvent);
+    epicsEventDestroy(connFirstEvent);
+    connEvent = NULL;
+    connDoneEvent = NULL;
+    connFirstEvent = NULL;
+}
+
+asynStatus drvTimRx::waitFirstConnect(epicsFloat64 wait)
+{
+    asynStatus status = asynSuccess;
+
+    if (connFirstEvent == NULL) {
+        return asynDisconnected;
+    }
+
+    if (epicsEventWaitWithTimeout(connFirstEvent, wait) != epicsEventOK) {
+        return asynTimeout;
+    }
+    /* Let later waiters through */
+    epicsEventSignal(connFirstEvent);
+
+    lock();
+    status = (timRxSharedClient != NULL)? asynSuccess : asynDisconnected;
+    unlock();
+
+    return status;
+}
+
+/* Connection manager. The first attempt is made right away. While
+ * disconnected, tries to reach the board with a backoff that doubles up
+ * to TIM_RX_CONN_BACKOFF_MAX. While connected,
+ * waits for a failed hardware access and checks whether the link is
+ * gone. The checks run on a reference of our own to the client and
+ * without the driver lock, so neither the port nor the shared poller
+ * wait on an unreachable broker */
+void drvTimRx::connTask(void)
+{
+    const char *functionName = "connTask";
+    epicsFloat64 backoff = TIM_RX_CONN_BACKOFF_MIN;
+    timRxSharedClient_t *sharedClient = NULL;
+    asynStatus status = asynSuccess;
+    bool connected = false;
+    bool firstAttempt = true;
+    epicsTimeStamp now;
+
+    lock();
+    while (!connTaskExit) {
+        connected = (timRxSharedClient != NULL);
+        unlock();
+
+        if (connected) {
+            /* Woken up when the breaker opens */
+            epicsEventWait(connEvent);
+            lock();
+            if (breakerState == breakerOpen) {
+                setBreakerState(breakerHalfOpen);
+                callParamCallbacks();
+            }
+            unlock();
+        }
+        else if (!firstAttempt) {
+            epicsEventWaitWithTimeout(connEvent, backoff);
+        }
+
+        sharedClient = timRxSharedClientAcquire(endpoint,
+                boardMap[timRxNumber].board, verbose, timeout, numWorkers);
+        status = (sharedClient != NULL)? probeClient(sharedClient) : asynDisconnected;
+
+        lock();
+        if (connTaskExit) {
+            break;
+        }
+
+        if (timRxSharedClient != NULL) {
+            if (status != asynSuccess && timRxSharedClient == sharedClient) {
+                asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
+                    "%s:%s: lost connection to %s\n",
+                    driverName, functionName, endpoint);
+                /* The clients may be stuck for good. The next acquire
+                 * creates new ones */
+                timRxSharedClientBreak(timRxSharedClient);
+                timRxClientDisconnect(this->pasynUserSelf);
+                /* Calls fail on the missing client until it is back */
+                setBreakerState(breakerOpen);
+                backoff = TIM_RX_CONN_BACKOFF_MIN;
+            }
+            else if (timRxSharedClientIsBroken(timRxSharedClient)) {
+                /* The other receiver of the board lost it and broke the
+                 * clients. Move to the new ones on the next attempt */
+                asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
+                    "%s:%s: dropping broken client of %s\n",
+                    driverName, functionName, endpoint);
+                timRxClientDisconnect(this->pasynUserSelf);
+                setBreakerState(breakerOpen);
+                backoff = TIM_RX_CONN_BACKOFF_MIN;
+            }
+            else if (status == asynSuccess) {
+                setBreakerState(breakerClosed);
+            }
+            callParamCallbacks();
+        }
+        else if (status == asynSuccess &&
+                timRxClientConnect(this->pasynUserSelf, sharedClient) == asynSuccess) {
+            asynPrint(this->pasynUserSelf, ASYN_TRACE_FLOW,
+                "%s:%s: connected to %s\n",
+                driverName, functionName, endpoint);
+            setBreakerState(breakerClosed);
+            /* Before iocInit the hardware holds the configuration. After
+             * it, the parameter library does */
+            if (!hwSnapshotDone && !interruptAccept) {
+                snapshotHw();
+                for (int addr = 0; addr < MAX_ADDR; ++addr) {
+                    callParamCallbacks(addr);
+                }
+            }
+            else {
+                reapplyConfig();
+            }
+            backoff = TIM_RX_CONN_BACKOFF_MIN;
+        }
+        else {
+            backoff = (2*backoff < TIM_RX_CONN_BACKOFF_MAX)?
+                2*backoff : TIM_RX_CONN_BACKOFF_MAX;
+        }
+
+        if (firstAttempt) {
+            firstAttempt = false;
+            /* If the HALCS broker is not reachable yet, we keep trying.
+             * Records stay in alarm meanwhile */
+            if (timRxSharedClient == NULL) {
+                asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
+                    "%s:%s: could not reach %s. Retrying in the background\n",
+                    driverName, functionName, endpoint);
+            }
+            epicsTimeGetCurrent(&now);
+            setDoubleParam(P_TimRxStartupTime, epicsTimeDiffInSeconds(&now, &createTime));
+            callParamCallbacks();
+            epicsEventSignal(connFirstEvent);
+        }
+
+        if (sharedClient != NULL) {
+            unlock();
+            timRxSharedClientRelease(sharedClient);
+            sharedClient = NULL;
+            lock();
+        }
+    }
+    unlock();
+
+    if (sharedClient != NULL) {
+        timRxSharedClientRelease(sharedClient);
+    }
+
+    epicsEventSignal(connDoneEvent);
+}
+
+/* Write the configuration held in the parameter library back to hardware
+ * after the link came back. Registers are read first, so the ones the
+ * hardware kept are not written again if write elision is on. Registers
+ * owned by hardware or written for their side effect are left alone.
+ * Must be called with the driver lock held */
+asynStatus drvTimRx::reapplyConfig()
+{
+    const char *functionName = "reapplyConfig";
+    asynStatus status = asynSuccess;
+    asynStatus writeStatus = asynSuccess;
+    functionsArgs_t functionArgs = {0};
+    unsigned numFailed = 0;
+
+    for (size_t i = 0; i < timRxNumParams; ++i) {
+        int functionId = this->*timRxParams[i].index;
+        const functionsHw_t *func = getHwFunc(functionId);
+
+        if (func == NULL || !func->hasWrite() ||
+                (timRxParams[i].flags &
+                    (TIM_RX_PARAM_VOLATILE | TIM_RX_PARAM_SIDE_EFFECT))) {
+            continue;
+        }
+
+        for (int addr = 0; addr < timRxParams[i].numAddr; ++addr) {
+            functionArgs.argUInt32 = 0;
+            if (executeHwReadFunction(functionId, addr, functionArgs) == asynSuccess) {
+                storeRegShadow(functionId, addr, functionArgs);
+            }
+
+            if (timRxParams[i].type == asynParamFloat64) {
+                writeStatus = setParamDouble(functionId, addr);
+            }
+            else {
+                writeStatus = setParam32(functionId, 0xFFFFFFFF, addr);
+            }
+
+            if (writeStatus != asynSuccess) {
+                ++numFailed;
+                status = writeStatus;
+            }
+            setParamStatus(addr, functionId, writeStatus);
+        }
+    }
+
+    for (int osc = 0; osc < si57xNumOsc; ++osc) {
+        refreshSi57xShadow(osc);
+    }
+
+    for (int addr = 0; addr < MAX_ADDR; ++addr) {
+        callParamCallbacks(addr);
+    }
+
+    if (numFailed > 0) {
+        asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
+            "%s:%s: %u registers could not be written\n",
+            driverName, functionName, numFailed);
+    }
+
+    return status;
+}
+
+/********************************************************************/
+/********************* Asyn overrided methods  **********************/
+/********************************************************************/
+
+/*
+ * Asyn overrided methods that are called by higher layers
+ */
+
+/** Called when asyn clients call pasynUInt32Digital->write().
+ * For all parameters it sets the value in the parameter library and calls any registered callbacks..
+ * \param[in] pasynUser pasynUser structure that encodes the reason and address.
+ * \param[in] value Value to write. */
+asynStatus drvTimRx::writeUInt32Digital(asynUser *pasynUser, epicsUInt32 value,
+        epicsUInt32 mask)
+{
+    int function = pasynUser->reason;
+    asynStatus status = asynSuccess;
+    int addr = 0;
+    int osc = -1;
+    int trigTime = -1;
+    int packed = -1;
+    const char *paramName;
+    const char* functionName = "writeUInt32Digital";
+
+    /* Get channel for possible use */
+    status = getAddress(pasynUser, &addr);
+    if (status) {
+        epicsSnprintf(pasynUser->errorMessage, pasynUser->errorMessageSize,
+                "%s:%s: status=%d, function=%d, name=%s, value=%d",
+                driverName, functionName, status, function, paramName, value);
+        return status;
+    }
+
+    if (function >= FIRST_COMMAND) {
+        /* Set the parameter in the parameter library. */
+        setUIntDigitalParam(addr, function, value, mask);
+        /* Fetch the parameter string name for possible use in debugging */
+        getParamName(function, &paramName);
+
+        if (function == P_TimRxRtmSi57xFreq) {
+            status = setRtmSi57xFreq(value, addr);
+        }
+        else if (function == P_TimRxAfcSi57xFreq) {
+            status = setAfcSi57xFreq(value, addr);
+        }
+        else if ((packed = getPacked(function)) >= 0) {
+            status = setPacked(packed, mask);
+        }
+        else if (queueWrite(function, mask, addr)) {
+            /* Held by the coalescing stage, flushTask writes it to HW */
+            status = asynSuccess;
+        }
+        else {
+            /* Do operation on HW. Some functions do not set anything on hardware */
+            status = setParam32(function, mask, addr);
+
+            /* A single Si57x register changed, the shadow must follow */
+            osc = getSi57xOsc(function);
+            if (status == asynSuccess && osc >= 0) {
+                refreshSi57xShadow(osc);
+            }
+        }
+
+        trigTime = getTrigTimeRaw(function);
+        if (trigTime >= 0) {
+            publishTrigTime(trigTime, addr);
+        }
+
+        packed = getPackedChan(function);
+        if (packed >= 0) {
+            publishPacked(packed);
+            callParamCallbacks(0);
+        }
+
+        /* Compare hold times from the switch on */
+        if (function == P_TimRxHwUnlock) {
+            resetLockStats();
+        }
+        else if (function == P_TimRxTraceDump) {
+            publishTrace(value);
+        }
+        else if (function == P_TimRxLatReset) {
+            resetLatStats();
+            publishLatStats();
+            callParamCallbacks();
+        }
+    }
+    else {
+        /* Call base class */
+        status = asynPortDriver::writeUInt32Digital(pasynUser, value, mask);
+    }
+
+    /* Do callbacks so higher layers see any changes */
+    callParamCallbacks(addr);
+
+    if (status)
+        epicsSnprintf(pasynUser->errorMessage, pasynUser->errorMessageSize,
+                "%s:%s: status=%d, function=%d, name=%s, value=%d",
+                driverName, functionName, status, function, paramName, value);
+    else
+        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER,
+                "%s:%s: function=%d, name=%s, value=%d\n",
+                driverName, functionName, function, paramName, value);
+    return status;
+}
+
+/** Called when asyn clients call pasynUInt32Digital->read().
+ * For all parameters it gets the value in the parameter library..
+ * \param[in] pasynUser pasynUser structure that encodes the reason and address.
+ * \param[out] value Value to read. */
+asynStatus drvTimRx::readUInt32Digital(asynUser *pasynUser, epicsUInt32 *value,
+        epicsUInt32 mask)
+{
+    int function = pasynUser->reason;
+    asynStatus status = asynSuccess;
+    int addr = 0;
+    int packed = -1;
+    const char *functionName = "readUInt32Digital";
+    const char *paramName;
+
+    /* Get channel for possible use */
+    status = getAddress(pasynUser, &addr);
+    if (status) {
+        epicsSnprintf(pasynUser->errorMessage, pasynUser->errorMessageSize,
+                "%s:%s: status=%d, function=%d, name=%s",
+                driverName, functionName, status, function, paramName);
+        return status;
+    }
+    /* Fetch the parameter string name for possible use in debugging */
+    getParamName(function, &paramName);
+
+    if (function >= FIRST_COMMAND) {
+        if (function == P_TimRxRtmSi57xFreq) {
+            status = getRtmSi57xFreq(value, addr);
+        }
+        else if (function == P_TimRxAfcSi57xFreq) {
+            status = getAfcSi57xFreq(value, addr);
+        }
+        else if ((packed = getPacked(function)) >= 0) {
+            status = getPackedHw(packed, value, mask);
+        }
+        else {
+            /* Get parameter, possibly from HW */
+            status = getParam32(function, value, mask, addr);
+        }
+    }
+    else {
+        /* Call base class */
+        status = asynPortDriver::readUInt32Digital(pasynUser, value, mask);
+    }
+
+    if (status)
+        epicsSnprintf(pasynUser->errorMessage, pasynUser->errorMessageSize,
+                "%s:%s: status=%d, function=%d, name=%s",
+                driverName, functionName, status, function, paramName);
+    else
+        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER,
+                "%s:%s: function=%d, name=%s\n",
+                driverName, functionName, function, paramName);
+
+    return status;
+}
+
+/** Called when asyn clients call pasynFloat64->write().
+  * \param[in] pasynUser pasynUser structure that encodes the reason and address.
+  * \param[in] value Value to read */
+asynStatus drvTimRx::writeFloat64(asynUser *pasynUser, epicsFloat64 value)
+{
+    int function = pasynUser->reason;
+    asynStatus status = asynSuccess;
+    int addr = 0;
+    int trigTime = -1;
+    const char *paramName;
+    const char* functionName = "writeFloat64";
+
+    /* Get channel for possible use */
+    status = getAddress(pasynUser, &addr);
+    if (status) {
+        epicsSnprintf(pasynUser->errorMessage, pasynUser->errorMessageSize,
+                "%s:%s: status=%d, function=%d, name=%s, value=%f",
+                driverName, functionName, status, function, paramName, value);
+        return status;
+    }
+
+    if (function == P_TimRxFpgaClk && !(value > 0.0)) {
+        epicsSnprintf(pasynUser->errorMessage, pasynUser->errorMessageSize,
+                "%s:%s: invalid FPGA clock %f",
+                driverName, functionName, value);
+        return asynError;
+    }
+
+    if (function >= FIRST_COMMAND) {
+        /* Set the parameter in the parameter library. */
+        setDoubleParam(addr, function, value);
+        /* Fetch the parameter string name for possible use in debugging */
+        getParamName(function, &paramName);
+
+        trigTime = getTrigTime(function);
+        if (trigTime >= 0) {
+            status = setTrigTime(trigTime, addr);
+        }
+        else {
+            /* Do operation on HW. Some functions do not set anything on hardware */
+            status = setParamDouble(function, addr);
+        }
+
+        /* Apply the new period right away */
+        if (function == P_TimRxStatusPollPeriod ||
+                function == P_TimRxCntPollPeriod ||
+                function == P_TimRxSi57xPollPeriod) {
+            pollRestart = true;
+            epicsEventSignal(timRxPollEvent);
+        }
+        else if (function == P_TimRxWriteHoldoff) {
+            /* Held writes are reevaluated against the new holdoff, and
+             * latencies compared from it on */
+            resetFlushStats();
+            signalFlushWorkers();
+        }
+        else if (function == P_TimRxFpgaClk) {
+            /* The hardware keeps its ticks, the times they stand for change */
+            publishTrigTimes();
+            for (int i = 1; i < MAX_ADDR; ++i) {
+                callParamCallbacks(i);
+            }
+        }
+    }
+    else {
+        /* Call base class */
+        status = asynPortDriver::writeFloat64(pasynUser, value);
+    }
+
+    /* Do callbacks so higher layers see any changes */
+    callParamCallbacks(addr);
+
+    if (status)
+        epicsSnprintf(pasynUser->errorMessage, pasynUser->errorMessageSize,
+                "%s:%s: status=%d, function=%d, name=%s, value=%f",
+                driverName, functionName, status, function, paramName, value);
+    else
+        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER,
+                "%s:%s: function=%d, name=%s, value=%f\n",
+                driverName, functionName, function, paramName, value);
+    return status;
+}
+
+/** Called when asyn clients call pasynFloat64->read().
+  * \param[in] pasynUser pasynUser structure that encodes the reason and address.
+  * \param[in] value Value to read */
+asynStatus drvTimRx::readFloat64(asynUser *pasynUser, epicsFloat64 *value)
+{
+    int function = pasynUser->reason;
+    asynStatus status = asynSuccess;
+    int addr = 0;
+    const char *paramName;
+    const char* functionName = "readFloat64";
+
+    /* Get channel for possible use */
+    status = getAddress(pasynUser, &addr);
+    if (status) {
+        epicsSnprintf(pasynUser->errorMessage, pasynUser->errorMessageSize,
+                "%s:%s: status=%d, function=%d, name=%s",
+                driverName, functionName, status, function, paramName);
+        return status;
+    }
+    /* Fetch the parameter string name for possible use in debugging */
+    getParamName(function, &paramName);
+
+    /* Get double param, possibly from HW */
+    if (function >= FIRST_COMMAND) {
+        if (function == P_TimRxRtmSi57xAge) {
+            status = getSi57xShadowAge(si57xRtm, value);
+        }
+        else if (function == P_TimRxAfcSi57xAge) {
+            status = getSi57xShadowAge(si57xAfc, value);
+        }
+        else if (function == P_TimRxBreakerOpenTime) {
+            status = getBreakerOpenTime(value);
+        }
+        else {
+            status = getParamDouble(function, value, addr);
+        }
+    }
+    else {
+        /* Call base class */
+        status = asynPortDriver::readFloat64(pasynUser, value);
+    }
+
+    if (status)
+        epicsSnprintf(pasynUser->errorMessage, pasynUser->errorMessageSize,
+                "%s:%s: status=%d, function=%d, name=%s",
+                driverName, functionName, status, function, paramName);
+    else
+        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER,
+                "%s:%s: function=%d, name=%s\n",
+                driverName, functionName, function, paramName);
+    return status;
+}
+
+/********************************************************************/
+/************ Function Mapping Overloaded Write functions ***********/
+/********************************************************************/
+
+asynStatus drvTimRx::doExecuteHwWriteFunction(hwAccess_t *access, const functionsFloat64_t &func,
+        char *service, int addr, functionsArgs_t &functionParam) const
+{
+    const char *functionName = "doExecuteHwWriteFunction<functionsFloat64_t>";
+    halcs_client_err_e err = HALCS_CLIENT_SUCCESS;
+    int status = asynSuccess;
+
+    /* Execute registered function */
+    err = func.write(access->client, service, functionParam.argFloat64);
+    access->called = true;
+    access->err = err;
+    if (err != HALCS_CLIENT_SUCCESS) {
+        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+                "%s:%s: failure executing write function for service %s,"
+                "param = %f\n",
+                driverName, functionName, service, functionParam.argFloat64);
+        status = asynError;
+        goto halcs_set_func_param_err;
+    }
+
+halcs_set_func_param_err:
+    return (asynStatus) status;
+}
+
+asynStatus drvTimRx::doExecuteHwWriteFunction(hwAccess_t *access, const functionsInt32Chan_t &func,
+        char *service, int addr, functionsArgs_t &functionParam) const
+{
+    const char *functionName = "doExecuteHwWriteFunction<functionsInt32Chan_t>";
+    halcs_client_err_e err = HALCS_CLIENT_SUCCESS;
+    int status = asynSuccess;
+    char serviceChanStr[SERVICE_NAME_SIZE];
+    int serviceID = 0;
+    epicsUInt32 serviceChan = addr;
+
+    /* Execute registered function */
+    err = func.write(access->client, service, serviceChan, functionParam.argUInt32);
+    access->called = true;
+    access->err = err;
+    if (err != HALCS_CLIENT_SUCCESS) {
+        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+                "%s:%s: failure executing write function for service %u,"
+                "param = %u\n",
+                driverName, functionName, serviceChan,
+                functionParam.argUInt32);
+        status = asynError;
+        goto halcs_set_func_param_err;
+    }
+
+halcs_set_func_param_err:
+get_service_id_err:
+    return (asynStatus) status;
+}
+
+asynStatus drvTimRx::doExecuteHwWriteFunction(hwAccess_t *access, const functionsInt32_t &func,
+        char *service, int addr, functionsArgs_t &functionParam) const
+{
+    const char *functionName = "doExecuteHwWriteFunction<functionsInt32_t>";
+    halcs_client_err_e err = HALCS_CLIENT_SUCCESS;
+    int status = asynSuccess;
+
+    /* Execute registered function */
+    err = func.write(access->client, service, functionParam.argUInt32);
+    access->called = true;
+    access->err = err;
+    if (err != HALCS_CLIENT_SUCCESS) {
+        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+                "%s:%s: failure executing write function for service %s,"
+                "param = %u\n",
+                driverName, functionName, service, functionParam.argUInt32);
+        status = asynError;
+        goto halcs_set_func_param_err;
+    }
+
+halcs_set_func_param_err:
+    return (asynStatus)status;
+}
+
+asynStatus drvTimRx::executeHwWriteFunction(int functionId, int addr,
+        functionsArgs_t &functionParam)
+{
+    int status = asynSuccess;
+    const char *functionName = "executeHwWriteFunction";
+    char *service = NULL;
+    const char *paramName = NULL;
+    const functionsHw_t *func = NULL;
+    hwAccess_t access;
+    epicsTimeStamp startTime;
+    epicsTimeStamp endTime;
+
+    /* Lookup function on registry */
+    func = getHwFunc(functionId);
+    if (func == NULL) {
+        getParamName(functionId, &paramName);
+        /* This is not an error. Exit silently */
+        status = asynSuccess;
+        asynPrint(this->pasynUserSelf, ASYN_TRACE_FLOW,
+                "%s:%s: no registered function for functionID = %d, name %s\n",
+                driverName, functionName, functionId, paramName);
+        goto get_reg_func_err;
+    }
+
+    /* Get full service name resolved at construction */
+    service = getServiceName(functionId);
+    if (service == NULL) {
+        status = asynError;
+        asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
+                "%s:%s: no service name for functionID = %d\n",
+                driverName, functionName, functionId);
+        goto get_service_err;
+    }
+
+    if (breakerState != breakerClosed) {
+        status = asynTimeout;
+        asynPrint(this->pasynUserSelf, ASYN_TRACE_FLOW,
+                "%s:%s: circuit breaker open, functionID = %d\n",
+                driverName, functionName, functionId);
+        goto breaker_open_err;
+    }
+
+    status = beginHwAccess(functionId, addr, &access);
+    if (status != asynSuccess) {
+        asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
+                "%s:%s: no client connected for functionID = %d\n",
+                driverName, functionName, functionId);
+        goto lock_client_err;
+    }
+
+    epicsTimeGetCurrent(&startTime);
+
+    /* Execute overloaded function for each function type we know of */
+    switch (func->type) {
+        case functionsHwInt32:
+            if (func->int32.write) {
+                status = doExecuteHwWriteFunction(&access, func->int32, service, addr, functionParam);
+            }
+        break;
+
+        case functionsHwInt32Chan:
+            if (func->int32Chan.write) {
+                status = doExecuteHwWriteFunction(&access, func->int32Chan, service, addr, functionParam);
+            }
+        break;
+
+        case functionsHwFloat64:
+            if (func->float64.write) {
+                status = doExecuteHwWriteFunction(&access, func->float64, service, addr, functionParam);
+            }
+        break;
+
+        default:
+        break;
+    }
+    if (access.called) {
+        epicsTimeGetCurrent(&endTime);
+        traceRecord(functionId, addr, 1, access.lane, functionParam,
+                &startTime, &endTime, access.err);
+    }
+    endHwAccess(&access);
+
+    if (status != asynDisabled) {
+        hwAccessDone((asynStatus)status, access.err);
+    }
+    if (status != asynSuccess) {
+        hwIoSlot = -1;
+    }
+
+lock_client_err:
+breaker_open_err:
+get_reg_func_err:
+get_service_err:
+        return (asynStatus)status;
+}
+
+/********************************************************************/
+/************ Function Mapping Overloaded Read functions ************/
+/********************************************************************/
+
+asynStatus drvTimRx::doExecuteHwReadFunction(hwAccess_t *access, const functionsFloat64_t &func,
+        char *service, int addr, functionsArgs_t &functionParam) const
+{
+    const char *functionName = "doExecuteHwReadFunction<functionsFloat64_t>";
+    halcs_client_err_e err = HALCS_CLIENT_SUCCESS;
+    int status = asynSuccess;
+
+    /* Execute registered function */
+    err = func.read(access->client, service, &functionParam.argFloat64);
+    access->called = true;
+    access->err = err;
+    if (err != HALCS_CLIENT_SUCCESS) {
+        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+                "%s:%s: failure executing read function for service %s\n",
+                driverName, functionName, service);
+        status = asynError;
+        goto halcs_get_func_param_err;
+    }
+
+halcs_get_func_param_err:
+    return (asynStatus) status;
+}
+
+asynStatus drvTimRx::doExecuteHwReadFunction(hwAccess_t *access, const functionsInt32Chan_t &func,
+        char *service, int addr, functionsArgs_t &functionParam) const
+{
+    const char *functionName = "doExecuteHwReadFunction<functionsInt32Chan_t>";
+    halcs_client_err_e err = HALCS_CLIENT_SUCCESS;
+    int status = asynSuccess;
+    epicsUInt32 serviceChan = addr;
+
+    /* Execute registered function */
+    err = func.read(access->client, service, serviceChan, &functionParam.argUInt32);
+    access->called = true;
+    access->err = err;
+    if (err != HALCS_CLIENT_SUCCESS) {
         asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
-                "%s:%s: failure executing write function for service %s,"
-                "param = %u\n",
-                driverName, functionName, serviceChan,
-                functionParam.argUInt32);
+                "%s:%s: failure executing read function for service %u\n",
+                driverName, functionName, serviceChan);
         status = asynError;
-        goto halcs_set_func_param_err;
+        goto halcs_get_func_param_err;
     }
 
-halcs_set_func_param_err:
+halcs_get_func_param_err:
 get_service_id_err:
     return (asynStatus) status;
 }
 
-asynStatus drvTimRx::doExecuteHwWriteFunction(functionsInt32_t &func, char *service,
-        int addr, functionsArgs_t &functionParam) const
+asynStatus drvTimRx::doExecuteHwReadFunction(hwAccess_t *access, const functionsInt32_t &func,
+        char *service, int addr, functionsArgs_t &functionParam) const
 {
-    const char *functionName = "doExecuteHwWriteFunction<functionsInt32_t>";
+    const char *functionName = "doExecuteHwReadFunction<functionsInt32_t>";
     halcs_client_err_e err = HALCS_CLIENT_SUCCESS;
     int status = asynSuccess;
 
     /* Execute registered function */
-    err = func.write(timRxClient, service, functionParam.argUInt32);
+    err = func.read(access->client, service, &functionParam.argUInt32);
+    access->called = true;
+    access->err = err;
     if (err != HALCS_CLIENT_SUCCESS) {
         asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
-                "%s:%s: failure executing write function for service %s,"
-                "param = %u\n",
-                driverName, functionName, service, functionParam.argUInt32);
+                "%s:%s: failure executing read function for service %s\n",
+                driverName, functionName, service);
         status = asynError;
-        goto halcs_set_func_param_err;
+        goto halcs_get_func_param_err;
+    }
+
+halcs_get_func_param_err:
+    return (asynStatus)status;
+}
+
+asynStatus drvTimRx::executeHwReadFunction(int functionId, int addr,
+        functionsArgs_t &functionParam)
+{
+    int status = asynSuccess;
+    const char *functionName = "executeHwReadFunction";
+    char *service = NULL;
+    const char *paramName = NULL;
+    const functionsHw_t *func = NULL;
+    hwAccess_t access;
+    epicsTimeStamp startTime;
+    epicsTimeStamp endTime;
+
+    /* Lookup function on registry */
+    func = getHwFunc(functionId);
+    if (func == NULL) {
+        getParamName(functionId, &paramName);
+        /* We use disabled to indicate the function was not found on Hw mapping */
+        status = asynDisabled;
+        asynPrint(this->pasynUserSelf, ASYN_TRACE_FLOW,
+                "%s:%s: no registered function for functionID = %d, name %s\n",
+                driverName, functionName, functionId, paramName);
+        goto get_reg_func_err;
+    }
+
+    /* Get full service name resolved at construction */
+    service = getServiceName(functionId);
+    if (service == NULL) {
+        status = asynError;
+        asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
+                "%s:%s: no service name for functionID = %d\n",
+                driverName, functionName, functionId);
+        goto get_service_err;
+    }
+
+    if (breakerState != breakerClosed) {
+        status = asynTimeout;
+        asynPrint(this->pasynUserSelf, ASYN_TRACE_FLOW,
+                "%s:%s: circuit breaker open, functionID = %d\n",
+                driverName, functionName, functionId);
+        goto breaker_open_err;
+    }
+
+    status = beginHwAccess(functionId, addr, &access);
+    if (status != asynSuccess) {
+        asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
+                "%s:%s: no client connected for functionID = %d\n",
+                driverName, functionName, functionId);
+        goto lock_client_err;
+    }
+
+    epicsTimeGetCurrent(&startTime);
+
+    /* Execute overloaded function for each function type we know of. Functions
+     * without a read method are served from the parameter library */
+    status = asynDisabled;
+    switch (func->type) {
+        case functionsHwInt32:
+            if (func->int32.read) {
+                status = doExecuteHwReadFunction(&access, func->int32, service, addr, functionParam);
+            }
+        break;
+
+        case functionsHwInt32Chan:
+            if (func->int32Chan.read) {
+                status = doExecuteHwReadFunction(&access, func->int32Chan, service, addr, functionParam);
+            }
+        break;
+
+        case functionsHwFloat64:
+            if (func->float64.read) {
+                status = doExecuteHwReadFunction(&access, func->float64, service, addr, functionParam);
+            }
+        break;
+
+        default:
+        break;
+    }
+    if (access.called) {
+        epicsTimeGetCurrent(&endTime);
+        traceRecord(functionId, addr, 0, access.lane, functionParam,
+                &startTime, &endTime, access.err);
+    }
+    endHwAccess(&access);
+
+    if (status != asynDisabled) {
+        hwAccessDone((asynStatus)status, access.err);
+    }
+    if (status != asynSuccess) {
+        hwIoSlot = -1;
+    }
+
+lock_client_err:
+breaker_open_err:
+get_reg_func_err:
+get_service_err:
+        return (asynStatus)status;
+}
+
+/********************************************************************/
+/*************** Generic 32-bit/Double Tim Rx Operations ***************/
+/********************************************************************/
+
+/*
+* 32-bit/Double generic Tim Rx operations. These will map to real
+* functions defined in the structures. e.g., functionsInt32_t
+* and functionsFloat64_t
+*/
+
+asynStatus drvTimRx::setParamGeneric(int functionId, int addr)
+{
+    int status = asynSuccess;
+    const char *functionName = "setParamGeneric";
+    const char *paramName = NULL;
+    asynParamType asynType = asynParamNotDefined;
+
+    getParamName(functionId, &paramName);
+    status = getParamType(addr, functionId, &asynType);
+    if (status != asynSuccess) {
+        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+                "%s:%s: getParamType failure retrieving asynParamType, "
+                "functionId = %d, paramName = %s\n",
+                driverName, functionName, functionId, paramName);
+        goto get_type_err;
+    }
+
+    switch (asynType) {
+        case asynParamUInt32Digital:
+            status = setParam32(functionId, 0xFFFFFFFF, addr);
+        break;
+
+        case asynParamFloat64:
+            status = setParamDouble(functionId, addr);
+        break;
+
+        default:
+            asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+                    "%s:%s: unsupported type for asynParamType: %d, "
+                    "functionId = %d, paramName = %s\n",
+                    driverName, functionName, asynType,
+                    functionId, paramName);
+            goto unsup_asyn_type;
+    }
+
+    if (status != asynSuccess) {
+        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+                "%s:%s: setParam32/setParamDouble failure setting value %d, "
+                "for functionId = %d, paramName = %s\n",
+                driverName, functionName, status, functionId, paramName);
+        goto set_type_err;
+    }
+
+set_type_err:
+unsup_asyn_type:
+get_type_err:
+    return (asynStatus)status;
+}
+
+
+asynStatus drvTimRx::setParam32(int functionId, epicsUInt32 mask, int addr)
+{
+    int status = asynSuccess;
+    functionsArgs_t functionArgs = {0};
+    cntState_t *counter = NULL;
+    bool partial = (mask != 0xFFFFFFFF && getHwFunc(functionId) != NULL);
+    const char *functionName = "setParam32";
+    const char *paramName = NULL;
+
+    status = getUIntDigitalParam(addr, functionId, &functionArgs.argUInt32, mask);
+    if (status != asynSuccess) {
+        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+                "%s:%s: getUIntDigitalParam failure for retrieving parameter %s\n",
+                driverName, functionName, paramName);
+        goto get_param_err;
+    }
+
+    /* A partial write keeps the bits outside mask as the hardware holds
+     * them, not as the parameter library does. The client is held from
+     * the read to the write, so no other write lands in between */
+    if (partial) {
+        status = lockClient();
+        if (status != asynSuccess) {
+            goto lock_client_err;
+        }
+
+        status = mergeHwBits(functionId, addr, mask, functionArgs);
+        if (status != asynSuccess) {
+            goto merge_hw_bits_err;
+        }
+    }
+
+    if (elideWrite(functionId, addr, functionArgs, asynParamUInt32Digital)) {
+        goto elide_write;
+    }
+
+    status = executeHwWriteFunction(functionId, addr, functionArgs);
+    if (status == asynSuccess) {
+        storeRegShadow(functionId, addr, functionArgs);
+
+        /* Let the counter sweep know the hardware counter restarted */
+        counter = getCntState(functionId, addr);
+        if (counter != NULL) {
+            ++counter->resetGen;
+        }
+    }
+
+elide_write:
+merge_hw_bits_err:
+    if (partial) {
+        unlockClient();
+    }
+lock_client_err:
+get_param_err:
+    return (asynStatus)status;
+}
+
+/* Fill the bits of functionArgs outside mask with the register contents,
+ * from the shadow if it is fresh or else from one hardware read. The
+ * parameter library is updated with the merged value. Registers without
+ * a read function merge with the parameter library instead */
+asynStatus drvTimRx::mergeHwBits(int functionId, int addr, epicsUInt32 mask,
+        functionsArgs_t &functionArgs)
+{
+    asynStatus status = asynSuccess;
+    functionsArgs_t hwArgs = {0};
+    const char *functionName = "mergeHwBits";
+
+    if (!readRegShadow(functionId, addr, hwArgs)) {
+        status = executeHwReadFunction(functionId, addr, hwArgs);
+        if (status == asynDisabled) {
+            status = getUIntDigitalParam(addr, functionId, &hwArgs.argUInt32,
+                    0xFFFFFFFF);
+        }
+        else if (status == asynSuccess) {
+            storeRegShadow(functionId, addr, hwArgs);
+        }
+    }
+
+    if (status != asynSuccess) {
+        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+                "%s:%s: could not read functionID = %d for a partial write\n",
+                driverName, functionName, functionId);
+        goto read_hw_err;
+    }
+
+    functionArgs.argUInt32 = (hwArgs.argUInt32 & ~mask) |
+        (functionArgs.argUInt32 & mask);
+    setUIntDigitalParam(addr, functionId, functionArgs.argUInt32, 0xFFFFFFFF);
+
+read_hw_err:
+    return status;
+}
+
+asynStatus drvTimRx::getParam32(int functionId, epicsUInt32 *param,
+        epicsUInt32 mask, int addr)
+{
+    int status = asynSuccess;
+    functionsArgs_t functionArgs = {0};
+    const char *functionName = "getParam32";
+    const char *paramName = NULL;
+
+    /* Get parameter in library, as some parameters are not written in HW */
+    status = getUIntDigitalParam(addr, functionId, param, mask);
+    if (status != asynSuccess) {
+        if (status != asynParamUndefined) {
+            getParamName(functionId, &paramName);
+            asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+                    "%s:%s: getUIntDigitalParam failure for retrieving parameter %s, status = %d\n",
+                    driverName, functionName, paramName, status);
+        }
+        goto get_param_err;
+    }
+
+    if (readRegShadow(functionId, addr, functionArgs)) {
+        status = asynSuccess;
+    }
+    else {
+        status = executeHwReadFunction(functionId, addr, functionArgs);
+        if (status == asynSuccess) {
+            storeRegShadow(functionId, addr, functionArgs);
+        }
+    }
+
+    if (status == asynSuccess) {
+        /* Mask parameter according to the received mask */
+        functionArgs.argUInt32 &= mask;
+        *param = functionArgs.argUInt32;
+    }
+    /* We recover from asynDisabled just by retrieving
+     * the parameter from the list */
+    else if (status == asynDisabled){
+        status = asynSuccess;
+    }
+
+get_param_err:
+    return (asynStatus)status;
+}
+
+asynStatus drvTimRx::setParamDouble(int functionId, int addr)
+{
+    asynStatus status = asynSuccess;
+    functionsArgs_t functionArgs = {0};
+    const char *functionName = "setParamDouble";
+    const char *paramName = NULL;
+
+    status = getDoubleParam(addr, functionId, &functionArgs.argFloat64);
+    if (status != asynSuccess) {
+        if (status != asynParamUndefined) {
+            getParamName(functionId, &paramName);
+            asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+                    "%s:%s: getDoubleParam failure for retrieving parameter %s\n",
+                    driverName, functionName, paramName);
+        }
+        goto get_param_err;
+    }
+
+    if (elideWrite(functionId, addr, functionArgs, asynParamFloat64)) {
+        goto elide_write;
     }
 
-halcs_set_func_param_err:
-    return (asynStatus)status;
+    status = executeHwWriteFunction(functionId, addr, functionArgs);
+    if (status == asynSuccess) {
+        storeRegShadow(functionId, addr, functionArgs);
+    }
+
+elide_write:
+get_param_err:
+    return status;
 }
 
-asynStatus drvTimRx::executeHwWriteFunction(int functionId, int addr,
-        functionsArgs_t &functionParam)
+asynStatus drvTimRx::getParamDouble(int functionId, epicsFloat64 *param, int addr)
 {
-    int status = asynSuccess;
-    const char *functionName = "executeHwWriteFunction";
-    const char *funcService = NULL;
-    char service[SERVICE_NAME_SIZE];
+    asynStatus status = asynSuccess;
+    functionsArgs_t functionArgs = {0};
+    const char *functionName = "getParamDouble";
     const char *paramName = NULL;
-    std::unordered_map<int,functionsAny_t>::iterator func;
 
-    /* Lookup function on map */
-    func = timRxHwFunc.find (functionId);
-    if (func == timRxHwFunc.end()) {
-        getParamName(functionId, &paramName);
-        /* This is not an error. Exit silently */
-        status = asynSuccess;
-        asynPrint(this->pasynUserSelf, ASYN_TRACE_FLOW,
-                "%s:%s: no registered function for functionID = %d, name %s\n",
-                driverName, functionName, functionId, paramName);
-        goto get_reg_func_err;
+    /* Get parameter in library, as some parameters are not written in HW */
+    status = getDoubleParam(addr, functionId, param);
+    if (status != asynSuccess) {
+        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
+                "%s:%s: getParamDouble failure for retrieving parameter %s\n",
+                driverName, functionName, paramName);
+        goto get_param_err;
     }
 
-    /* Get service name from structure */
-    funcService = func->second.getServiceName(*this);
-    /* Create full service name*/
-    status = getFullServiceName (this->timRxNumber, addr, funcService,
-            service, sizeof(service));
-    if (status) {
-        asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
-                "%s:%s: error calling getFullServiceName, status=%d\n",
-                driverName, functionName, status);
-        goto get_service_err;
+    if (readRegShadow(functionId, addr, functionArgs)) {
+        status = asynSuccess;
+    }
+    else {
+        status = executeHwReadFunction(functionId, addr, functionArgs);
+        if (status == asynSuccess) {
+            storeRegShadow(functionId, addr, functionArgs);
+        }
     }
 
-    /* Execute overloaded function for each function type we know of */
-    status = func->second.executeHwWrite(*this, service, addr, functionParam);
+    if (status == asynSuccess) {
+        *param = functionArgs.argFloat64;
+    }
+    /* We recover from asynDisabled just by retrieving
+     * the parameter from the list */
+    else if (status == asynDisabled){
+        status = asynSuccess;
+    }
 
-get_reg_func_err:
-get_service_err:
-        return (asynStatus)status;
+get_param_err:
+    return status;
 }
 
 /********************************************************************/
-/************ Function Mapping Overloaded Read functions ************/
+/*********************** Misc BPM Operations ************************/
 /********************************************************************/
 
-asynStatus drvTimRx::doExecuteHwReadFunction(functionsFloat64_t &func, char *service,
-        int addr, functionsArgs_t &functionParam) const
+/*
+ * Miscellaneous functions that don't map easily
+ * to our generic handlers get/setParam[32/Double]
+ */
+
+asynStatus drvTimRx::setSi57xFreq(epicsUInt32 value, si57xRegs_t *regs)
 {
-    const char *functionName = "doExecuteHwReadFunction<functionsFloat64_t>";
-    halcs_client_err_e err = HALCS_CLIENT_SUCCESS;
     int status = asynSuccess;
+    const char* functionName = "setSi57xFreq";
 
-    /* Execute registered function */
-    err = func.read(timRxClient, service, &functionParam.argFloat64);
-    if (err != HALCS_CLIENT_SUCCESS) {
-        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
-                "%s:%s: failure executing read function for service %s\n",
-                driverName, functionName, service);
+    if (!si57xSolver.solve(value, regs)) {
+        asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
+                "%s:%s: no Si57x divider setting for %u Hz, valid range "
+                "is %llu to %llu Hz\n", driverName, functionName, value,
+                (unsigned long long) SI57X_FOUT_MIN,
+                (unsigned long long) SI57X_FOUT_MAX);
         status = asynError;
-        goto halcs_get_func_param_err;
     }
 
-halcs_get_func_param_err:
-    return (asynStatus) status;
+    return (asynStatus)status;
 }
 
-asynStatus drvTimRx::doExecuteHwReadFunction(functionsInt32Chan_t &func, char *service,
-        int addr, functionsArgs_t &functionParam) const
+asynStatus drvTimRx::setRtmSi57xFreq(epicsUInt32 value, int addr)
 {
-    const char *functionName = "doExecuteHwReadFunction<functionsInt32Chan_t>";
-    halcs_client_err_e err = HALCS_CLIENT_SUCCESS;
+    int err = HALCS_CLIENT_SUCCESS;
+    char *service = NULL;
     int status = asynSuccess;
-    epicsUInt32 serviceChan = addr;
+    const char* functionName = "setRtmSi57xFreq";
 
-    /* Execute registered function */
-    err = func.read(timRxClient, service, serviceChan, &functionParam.argUInt32);
-    if (err != HALCS_CLIENT_SUCCESS) {
-        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
-                "%s:%s: failure executing read function for service %u\n",
-                driverName, functionName, serviceChan);
+    si57xRegs_t regs;
+    uint32_t n1, hs_div, ReqLo, ReqHi;
+    epicsTimeStamp startTime;
+    epicsTimeStamp endTime;
+
+    status = setSi57xFreq(value, &regs);
+    if (status != asynSuccess) {
+        goto set_Si57xFreq_err;
+    }
+
+    /* Get correct service name*/
+    service = getServiceName(P_TimRxRtmSi57xFreq);
+    if (service == NULL) {
         status = asynError;
-        goto halcs_get_func_param_err;
+        asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
+                "%s:%s: no service name for Si57x function\n",
+                driverName, functionName);
+        goto get_service_err;
     }
 
-halcs_get_func_param_err:
-get_service_id_err:
-    return (asynStatus) status;
-}
+    status = lockClient();
+    if (status != asynSuccess) {
+        goto lock_client_err;
+    }
 
-asynStatus drvTimRx::doExecuteHwReadFunction(functionsInt32_t &func, char *service,
-        int addr, functionsArgs_t &functionParam) const
-{
-    const char *functionName = "doExecuteHwReadFunction<functionsInt32_t>";
-    halcs_client_err_e err = HALCS_CLIENT_SUCCESS;
-    int status = asynSuccess;
+    epicsTimeGetCurrent(&startTime);
+    err = afc_timing_set_rtm_n1(timRxClient, service, regs.n1);
+    if (err == HALCS_CLIENT_SUCCESS) {
+        err = afc_timing_set_rtm_hs_div(timRxClient, service, regs.hsDiv);
+    }
+    if (err == HALCS_CLIENT_SUCCESS) {
+        err = afc_timing_set_rtm_rfreq_lo(timRxClient, service, regs.rfreqLo);
+    }
+    if (err == HALCS_CLIENT_SUCCESS) {
+        err = afc_timing_set_rtm_rfreq_hi(timRxClient, service, regs.rfreqHi);
+    }
+    if (err != HALCS_CLIENT_SUCCESS) {
+        unlockClient();
+        epicsTimeGetCurrent(&endTime);
+        latRecord(P_TimRxRtmSi57xFreq, latOpSi57x, epicsTimeDiffInSeconds(&endTime, &startTime), err);
+        status = asynError;
+        hwAccessDone((asynStatus)status, (halcs_client_err_e)err);
+        goto set_RtmSi57xFreq_err;
+    }
 
-    /* Execute registered function */
-    err = func.read(timRxClient, service, &functionParam.argUInt32);
+    err = afc_timing_get_rtm_n1(timRxClient, service, &n1);
+    if (err == HALCS_CLIENT_SUCCESS) {
+        err = afc_timing_get_rtm_hs_div(timRxClient, service, &hs_div);
+    }
+    if (err == HALCS_CLIENT_SUCCESS) {
+        err = afc_timing_get_rtm_rfreq_lo(timRxClient, service, &ReqLo);
+    }
+    if (err == HALCS_CLIENT_SUCCESS) {
+        err = afc_timing_get_rtm_rfreq_hi(timRxClient, service, &ReqHi);
+    }
+    unlockClient();
+    epicsTimeGetCurrent(&endTime);
+    latRecord(P_TimRxRtmSi57xFreq, latOpSi57x, epicsTimeDiffInSeconds(&endTime, &startTime), err);
+    hwAccessDone((err == HALCS_CLIENT_SUCCESS)? asynSuccess : asynError,
+            (halcs_client_err_e)err);
     if (err != HALCS_CLIENT_SUCCESS) {
-        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
-                "%s:%s: failure executing read function for service %s\n",
-                driverName, functionName, service);
+        asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
+                "%s:%s: could not read back the Si57x registers\n",
+                driverName, functionName);
         status = asynError;
-        goto halcs_get_func_param_err;
+        goto get_RtmSi57xRegs_err;
     }
 
-halcs_get_func_param_err:
+    updateSi57xShadow(si57xRtm, n1, hs_div, ReqLo, ReqHi);
+    setDoubleParam(si57xParams[si57xRtm].freqErr, regs.freqErr);
+    return (asynStatus)status;
+
+    /* Some registers may have been written. The shadow is only trusted
+     * again once refreshSi57xShadow reads them all */
+get_RtmSi57xRegs_err:
+set_RtmSi57xFreq_err:
+    si57xShadow[si57xRtm].valid = false;
+    setParamStatus(si57xParams[si57xRtm].freq, (asynStatus)status);
+lock_client_err:
+get_service_err:
+set_Si57xFreq_err:
     return (asynStatus)status;
 }
 
-asynStatus drvTimRx::executeHwReadFunction(int functionId, int addr,
-        functionsArgs_t &functionParam)
+asynStatus drvTimRx::setAfcSi57xFreq(epicsUInt32 value, int addr)
 {
+    int err = HALCS_CLIENT_SUCCESS;
+    char *service = NULL;
     int status = asynSuccess;
-    const char *functionName = "executeHwReadFunction";
-    const char *funcService = NULL;
-    char service[SERVICE_NAME_SIZE];
-    const char *paramName = NULL;
-    std::unordered_map<int,functionsAny_t>::iterator func;
+    const char* functionName = "setAfcSi57xFreq";
 
-    /* Lookup function on map */
-    func = timRxHwFunc.find (functionId);
-    if (func == timRxHwFunc.end()) {
-        getParamName(functionId, &paramName);
-        /* We use disabled to indicate the function was not found on Hw mapping */
-        status = asynDisabled;
-        asynPrint(this->pasynUserSelf, ASYN_TRACE_FLOW,
-                "%s:%s: no registered function for functionID = %d, name %s\n",
-                driverName, functionName, functionId, paramName);
-        goto get_reg_func_err;
+    si57xRegs_t regs;
+    uint32_t n1, hs_div, ReqLo, ReqHi;
+    epicsTimeStamp startTime;
+    epicsTimeStamp endTime;
+
+    status = setSi57xFreq(value, &regs);
+    if (status != asynSuccess) {
+        goto set_Si57xFreq_err;
     }
 
-    /* Get service name from structure */
-    funcService = func->second.getServiceName(*this);
-    /* Create full service name*/
-    status = getFullServiceName (this->timRxNumber, addr, funcService,
-            service, sizeof(service));
-    if (status) {
+    /* Get correct service name*/
+    service = getServiceName(P_TimRxAfcSi57xFreq);
+    if (service == NULL) {
+        status = asynError;
         asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
-                "%s:%s: error calling getFullServiceName, status=%d\n",
-                driverName, functionName, status);
+                "%s:%s: no service name for Si57x function\n",
+                driverName, functionName);
         goto get_service_err;
     }
 
-    /* Execute overloaded function for each function type we know of */
-    status = func->second.executeHwRead(*this, service, addr, functionParam);
+    status = lockClient();
+    if (status != asynSuccess) {
+        goto lock_client_err;
+    }
 
-get_reg_func_err:
-get_service_err:
-        return (asynStatus)status;
-}
+    epicsTimeGetCurrent(&startTime);
+    err = afc_timing_set_afc_n1(timRxClient, service, regs.n1);
+    if (err == HALCS_CLIENT_SUCCESS) {
+        err = afc_timing_set_afc_hs_div(timRxClient, service, regs.hsDiv);
+    }
+    if (err == HALCS_CLIENT_SUCCESS) {
+        err = afc_timing_set_afc_rfreq_lo(timRxClient, service, regs.rfreqLo);
+    }
+    if (err == HALCS_CLIENT_SUCCESS) {
+        err = afc_timing_set_afc_rfreq_hi(timRxClient, service, regs.rfreqHi);
+    }
+    if (err != HALCS_CLIENT_SUCCESS) {
+        unlockClient();
+        epicsTimeGetCurrent(&endTime);
+        latRecord(P_TimRxAfcSi57xFreq, latOpSi57x, epicsTimeDiffInSeconds(&endTime, &startTime), err);
+        status = asynError;
+        hwAccessDone((asynStatus)status, (halcs_client_err_e)err);
+        goto set_AfcSi57xFreq_err;
+    }
 
-/********************************************************************/
-/*************** Generic 32-bit/Double Tim Rx Operations ***************/
-/********************************************************************/
+    err = afc_timing_get_afc_n1(timRxClient, service, &n1);
+    if (err == HALCS_CLIENT_SUCCESS) {
+        err = afc_timing_get_afc_hs_div(timRxClient, service, &hs_div);
+    }
+    if (err == HALCS_CLIENT_SUCCESS) {
+        err = afc_timing_get_afc_rfreq_lo(timRxClient, service, &ReqLo);
+    }
+    if (err == HALCS_CLIENT_SUCCESS) {
+        err = afc_timing_get_afc_rfreq_hi(timRxClient, service, &ReqHi);
+    }
+    unlockClient();
+    epicsTimeGetCurrent(&endTime);
+    latRecord(P_TimRxAfcSi57xFreq, latOpSi57x, epicsTimeDiffInSeconds(&endTime, &startTime), err);
+    hwAccessDone((err == HALCS_CLIENT_SUCCESS)? asynSuccess : asynError,
+            (halcs_client_err_e)err);
+    if (err != HALCS_CLIENT_SUCCESS) {
+        asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
+                "%s:%s: could not read back the Si57x registers\n",
+                driverName, functionName);
+        status = asynError;
+        goto get_AfcSi57xRegs_err;
+    }
 
-/*
-* 32-bit/Double generic Tim Rx operations. These will map to real
-* functions defined in the structures. e.g., functionsInt32_t
-* and functionsFloat64_t
-*/
+    updateSi57xShadow(si57xAfc, n1, hs_div, ReqLo, ReqHi);
+    setDoubleParam(si57xParams[si57xAfc].freqErr, regs.freqErr);
+    return (asynStatus)status;
 
-asynStatus drvTimRx::setParamGeneric(int functionId, int addr)
+    /* Some registers may have been written. The shadow is only trusted
+     * again once refreshSi57xShadow reads them all */
+get_AfcSi57xRegs_err:
+set_AfcSi57xFreq_err:
+    si57xShadow[si57xAfc].valid = false;
+    setParamStatus(si57xParams[si57xAfc].freq, (asynStatus)status);
+lock_client_err:
+get_service_err:
+set_Si57xFreq_err:
+    return (asynStatus)status;
+}
+
+asynStatus drvTimRx::getSi57xFreq(epicsUInt32 *value, uint32_t n1, uint32_t hs_div, uint32_t ReqLo, uint32_t ReqHi)
 {
     int status = asynSuccess;
-    const char *functionName = "setParamGeneric";
-    const char *paramName = NULL;
-    asynParamType asynType = asynParamNotDefined;
 
-    getParamName(functionId, &paramName);
-    status = getParamType(addr, functionId, &asynType);
-    if (status != asynSuccess) {
-        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
-                "%s:%s: getParamType failure retrieving asynParamType, "
-                "functionId = %d, paramName = %s\n",
-                driverName, functionName, functionId, paramName);
-        goto get_type_err;
-    }
+    *value = epicsUInt32(Si57xSolver::outputFreq(n1, hs_div, ReqLo, ReqHi) + 0.5);
 
-    switch (asynType) {
-        case asynParamUInt32Digital:
-            status = setParam32(functionId, 0xFFFFFFFF, addr);
-        break;
+    return (asynStatus)status;
+}
 
-        case asynParamFloat64:
-            status = setParamDouble(functionId, addr);
-        break;
+asynStatus drvTimRx::getRtmSi57xFreq(epicsUInt32 *value, int addr)
+{
+    return getSi57xShadowFreq(si57xRtm, value);
+}
 
-        default:
-            asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
-                    "%s:%s: unsupported type for asynParamType: %d, "
-                    "functionId = %d, paramName = %s\n",
-                    driverName, functionName, asynType,
-                    functionId, paramName);
-            goto unsup_asyn_type;
-    }
+asynStatus drvTimRx::getAfcSi57xFreq(epicsUInt32 *value, int addr)
+{
+    return getSi57xShadowFreq(si57xAfc, value);
+}
 
-    if (status != asynSuccess) {
-        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
-                "%s:%s: setParam32/setParamDouble failure setting value %d, "
-                "for functionId = %d, paramName = %s\n",
-                driverName, functionName, status, functionId, paramName);
-        goto set_type_err;
+/* Bind the Si57x shadows to their parameters. The shadows start invalid
+ * and are filled on first use */
+void drvTimRx::initSi57xShadow()
+{
+    si57xParams[si57xRtm].freq = P_TimRxRtmSi57xFreq;
+    si57xParams[si57xRtm].n1 = P_TimRxRtmN1;
+    si57xParams[si57xRtm].hsDiv = P_TimRxRtmHsDiv;
+    si57xParams[si57xRtm].rfreqLo = P_TimRxRtmRfreqLo;
+    si57xParams[si57xRtm].rfreqHi = P_TimRxRtmRfreqHi;
+    si57xParams[si57xRtm].age = P_TimRxRtmSi57xAge;
+    si57xParams[si57xRtm].freqErr = P_TimRxRtmSi57xFreqErr;
+
+    si57xParams[si57xAfc].freq = P_TimRxAfcSi57xFreq;
+    si57xParams[si57xAfc].n1 = P_TimRxAfcN1;
+    si57xParams[si57xAfc].hsDiv = P_TimRxAfcHsDiv;
+    si57xParams[si57xAfc].rfreqLo = P_TimRxAfcRfreqLo;
+    si57xParams[si57xAfc].rfreqHi = P_TimRxAfcRfreqHi;
+    si57xParams[si57xAfc].age = P_TimRxAfcSi57xAge;
+    si57xParams[si57xAfc].freqErr = P_TimRxAfcSi57xFreqErr;
+
+    for (int osc = 0; osc < si57xNumOsc; ++osc) {
+        si57xShadow[osc].valid = false;
     }
+}
 
-set_type_err:
-unsup_asyn_type:
-get_type_err:
-    return (asynStatus)status;
+void drvTimRx::initTrigTimeParams()
+{
+    const trigTimeParams_t params[trigTimeNum] = {
+        {P_TimRxAmcDly, P_TimRxAmcDelay, MAX_AMC_TRIGGER_CH},
+        {P_TimRxAmcWdt, P_TimRxAmcWidth, MAX_AMC_TRIGGER_CH},
+        {P_TimRxFmc1Dly, P_TimRxFmc1Delay, MAX_FMC1_TRIGGER_CH},
+        {P_TimRxFmc1Wdt, P_TimRxFmc1Width, MAX_FMC1_TRIGGER_CH},
+        {P_TimRxFmc2Dly, P_TimRxFmc2Delay, MAX_FMC2_TRIGGER_CH},
+        {P_TimRxFmc2Wdt, P_TimRxFmc2Width, MAX_FMC2_TRIGGER_CH}
+    };
+
+    for (int i = 0; i < trigTimeNum; ++i) {
+        trigTimeParams[i] = params[i];
+    }
 }
 
+/* Return the trigger channel time a microsecond parameter belongs to,
+ * or -1 */
+int drvTimRx::getTrigTime(int functionId) const
+{
+    for (int i = 0; i < trigTimeNum; ++i) {
+        if (functionId == trigTimeParams[i].eu) {
+            return i;
+        }
+    }
 
-asynStatus drvTimRx::setParam32(int functionId, epicsUInt32 mask, int addr)
+    return -1;
+}
+
+/* Return the trigger channel time a tick parameter belongs to, or -1 */
+int drvTimRx::getTrigTimeRaw(int functionId) const
 {
-    int status = asynSuccess;
-    functionsArgs_t functionArgs = {0};
-    const char *functionName = "setParam32";
-    const char *paramName = NULL;
+    for (int i = 0; i < trigTimeNum; ++i) {
+        if (functionId == trigTimeParams[i].raw) {
+            return i;
+        }
+    }
 
-    status = getUIntDigitalParam(addr, functionId, &functionArgs.argUInt32, mask);
-    if (status != asynSuccess) {
+    return -1;
+}
+
+/* Convert a trigger channel time set in microseconds to FPGA clock ticks
+ * and write it like a tick setpoint would be. The parameter then holds
+ * the time the ticks stand for */
+asynStatus drvTimRx::setTrigTime(int trigTime, int addr)
+{
+    asynStatus status = asynSuccess;
+    const trigTimeParams_t &params = trigTimeParams[trigTime];
+    const char *functionName = "setTrigTime";
+    epicsFloat64 time = 0.0;
+    epicsFloat64 clk = 0.0;
+    epicsFloat64 ticks = 0.0;
+
+    getDoubleParam(addr, params.eu, &time);
+    getDoubleParam(P_TimRxFpgaClk, &clk);
+
+    ticks = floor(time*clk/1e6 + 0.5);
+    /* NaN fails every comparison, so it would pass the range check */
+    if (!std::isfinite(ticks) || ticks < 0.0 || ticks > 0xFFFFFFFF) {
         asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
-                "%s:%s: getUIntDigitalParam failure for retrieving parameter %s\n",
-                driverName, functionName, paramName);
-        goto get_param_err;
+                "%s:%s: %f us is out of the hardware range\n",
+                driverName, functionName, time);
+        status = asynError;
+        goto out_of_range_err;
     }
 
-    status = executeHwWriteFunction(functionId, addr, functionArgs);
+    setUIntDigitalParam(addr, params.raw, (epicsUInt32)ticks, 0xFFFFFFFF);
+    if (!queueWrite(params.raw, 0xFFFFFFFF, addr)) {
+        status = setParam32(params.raw, 0xFFFFFFFF, addr);
+    }
 
-get_param_err:
-    return (asynStatus)status;
+out_of_range_err:
+    publishTrigTime(trigTime, addr);
+    return status;
 }
 
-asynStatus drvTimRx::getParam32(int functionId, epicsUInt32 *param,
-        epicsUInt32 mask, int addr)
+/* Set the microsecond parameter of a trigger channel time from its
+ * ticks */
+void drvTimRx::publishTrigTime(int trigTime, int addr)
 {
-    int status = asynSuccess;
-    functionsArgs_t functionArgs = {0};
-    const char *functionName = "getParam32";
-    const char *paramName = NULL;
+    const trigTimeParams_t &params = trigTimeParams[trigTime];
+    epicsUInt32 ticks = 0;
+    epicsFloat64 clk = 0.0;
 
-    /* Get parameter in library, as some parameters are not written in HW */
-    status = getUIntDigitalParam(addr, functionId, param, mask);
-    if (status != asynSuccess) {
-        if (status != asynParamUndefined) {
-            getParamName(functionId, &paramName);
-            asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
-                    "%s:%s: getUIntDigitalParam failure for retrieving parameter %s, status = %d\n",
-                    driverName, functionName, paramName, status);
+    getUIntDigitalParam(addr, params.raw, &ticks, 0xFFFFFFFF);
+    getDoubleParam(P_TimRxFpgaClk, &clk);
+    setDoubleParam(addr, params.eu, ticks*1e6/clk);
+}
+
+/* Refresh every microsecond parameter. Callers do the callbacks */
+void drvTimRx::publishTrigTimes()
+{
+    for (int i = 0; i < trigTimeNum; ++i) {
+        for (int addr = 0; addr < trigTimeParams[i].numChannels; ++addr) {
+            publishTrigTime(i, addr);
         }
-        goto get_param_err;
     }
+}
 
-    status = executeHwReadFunction(functionId, addr, functionArgs);
-    if (status == asynSuccess) {
-        /* Mask parameter according to the received mask */
-        functionArgs.argUInt32 &= mask;
-        *param = functionArgs.argUInt32;
+void drvTimRx::initPackedParams()
+{
+    const packedParams_t params[] = {
+        {P_TimRxAmcEnMask, P_TimRxAmcEn, MAX_AMC_TRIGGER_CH},
+        {P_TimRxAmcPolMask, P_TimRxAmcPol, MAX_AMC_TRIGGER_CH},
+        {P_TimRxAmcLogMask, P_TimRxAmcLog, MAX_AMC_TRIGGER_CH},
+        {P_TimRxAmcItlMask, P_TimRxAmcItl, MAX_AMC_TRIGGER_CH},
+        {P_TimRxAmcDirMask, P_TimRxAmcDir, MAX_AMC_TRIGGER_CH},
+        {P_TimRxFmc1EnMask, P_TimRxFmc1En, MAX_FMC1_TRIGGER_CH},
+        {P_TimRxFmc1PolMask, P_TimRxFmc1Pol, MAX_FMC1_TRIGGER_CH},
+        {P_TimRxFmc1LogMask, P_TimRxFmc1Log, MAX_FMC1_TRIGGER_CH},
+        {P_TimRxFmc1ItlMask, P_TimRxFmc1Itl, MAX_FMC1_TRIGGER_CH},
+        {P_TimRxFmc1DirMask, P_TimRxFmc1Dir, MAX_FMC1_TRIGGER_CH},
+        {P_TimRxFmc2EnMask, P_TimRxFmc2En, MAX_FMC2_TRIGGER_CH},
+        {P_TimRxFmc2PolMask, P_TimRxFmc2Pol, MAX_FMC2_TRIGGER_CH},
+        {P_TimRxFmc2LogMask, P_TimRxFmc2Log, MAX_FMC2_TRIGGER_CH},
+        {P_TimRxFmc2ItlMask, P_TimRxFmc2Itl, MAX_FMC2_TRIGGER_CH},
+        {P_TimRxFmc2DirMask, P_TimRxFmc2Dir, MAX_FMC2_TRIGGER_CH}
+    };
+
+    packedParams.assign(params, params + ARRAY_SIZE(params));
+}
+
+/* Return the packed trigger attribute of a packed parameter, or -1 */
+int drvTimRx::getPacked(int functionId) const
+{
+    for (size_t i = 0; i < packedParams.size(); ++i) {
+        if (functionId == packedParams[i].packed) {
+            return i;
+        }
     }
-    /* We recover from asynDisabled just by retrieving
-     * the parameter from the list */
-    else if (status == asynDisabled){
-        status = asynSuccess;
+
+    return -1;
+}
+
+/* Return the packed trigger attribute of a channel parameter, or -1 */
+int drvTimRx::getPackedChan(int functionId) const
+{
+    for (size_t i = 0; i < packedParams.size(); ++i) {
+        if (functionId == packedParams[i].chan) {
+            return i;
+        }
     }
 
-get_param_err:
-    return (asynStatus)status;
+    return -1;
 }
 
-asynStatus drvTimRx::setParamDouble(int functionId, int addr)
+/* Write the channels selected by mask from the packed parameter. The
+ * HALCS client is held across the whole bank, so the other receiver of
+ * the board sees it change at once. Channels already holding their bit
+ * are elided as usual */
+asynStatus drvTimRx::setPacked(int packed, epicsUInt32 mask)
 {
     asynStatus status = asynSuccess;
-    functionsArgs_t functionArgs = {0};
-    const char *functionName = "setParamDouble";
-    const char *paramName = NULL;
+    asynStatus chanStatus = asynSuccess;
+    const packedParams_t &params = packedParams[packed];
+    const char *functionName = "setPacked";
+    epicsUInt32 value = 0;
 
-    status = getDoubleParam(addr, functionId, &functionArgs.argFloat64);
+    getUIntDigitalParam(params.packed, &value, 0xFFFFFFFF);
+
+    status = lockClient();
     if (status != asynSuccess) {
-        if (status != asynParamUndefined) {
-            getParamName(functionId, &paramName);
-            asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
-                    "%s:%s: getDoubleParam failure for retrieving parameter %s\n",
-                    driverName, functionName, paramName);
+        asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
+                "%s:%s: no client connected\n",
+                driverName, functionName);
+        goto lock_client_err;
+    }
+
+    for (int addr = 0; addr < params.numChannels; ++addr) {
+        if (!(mask & (1 << addr))) {
+            continue;
         }
-        goto get_param_err;
+
+        setUIntDigitalParam(addr, params.chan, (value >> addr) & 0x1, 0xFFFFFFFF);
+        chanStatus = setParam32(params.chan, 0xFFFFFFFF, addr);
+        if (chanStatus != asynSuccess) {
+            status = chanStatus;
+        }
+        setParamStatus(addr, params.chan, chanStatus);
     }
+    unlockClient();
 
-    status = executeHwWriteFunction(functionId, addr, functionArgs);
+    for (int addr = 1; addr < params.numChannels; ++addr) {
+        callParamCallbacks(addr);
+    }
 
-get_param_err:
+lock_client_err:
+    publishPacked(packed);
     return status;
 }
 
-asynStatus drvTimRx::getParamDouble(int functionId, epicsFloat64 *param, int addr)
+/* Read the channels selected by mask and pack them, holding the HALCS
+ * client across the whole bank. Fresh shadow entries spare the reads */
+asynStatus drvTimRx::getPackedHw(int packed, epicsUInt32 *value, epicsUInt32 mask)
 {
     asynStatus status = asynSuccess;
-    functionsArgs_t functionArgs = {0};
-    const char *functionName = "getParamDouble";
-    const char *paramName = NULL;
+    asynStatus chanStatus = asynSuccess;
+    const packedParams_t &params = packedParams[packed];
+    const char *functionName = "getPackedHw";
+    epicsUInt32 word = 0;
+    epicsUInt32 bit = 0;
 
-    /* Get parameter in library, as some parameters are not written in HW */
-    status = getDoubleParam(addr, functionId, param);
+    status = lockClient();
     if (status != asynSuccess) {
-        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR,
-                "%s:%s: getParamDouble failure for retrieving parameter %s\n",
-                driverName, functionName, paramName);
-        goto get_param_err;
+        asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
+                "%s:%s: no client connected\n",
+                driverName, functionName);
+        goto lock_client_err;
     }
 
-    status = executeHwReadFunction(functionId, addr, functionArgs);
-    if (status == asynSuccess) {
-        *param = functionArgs.argFloat64;
-    }
-    /* We recover from asynDisabled just by retrieving
-     * the parameter from the list */
-    else if (status == asynDisabled){
-        status = asynSuccess;
+    for (int addr = 0; addr < params.numChannels; ++addr) {
+        if (!(mask & (1 << addr))) {
+            continue;
+        }
+
+        chanStatus = getParam32(params.chan, &bit, 0x1, addr);
+        if (chanStatus != asynSuccess) {
+            status = chanStatus;
+            continue;
+        }
+        word |= (bit & 0x1) << addr;
     }
+    unlockClient();
 
-get_param_err:
+    *value = word & mask;
+
+lock_client_err:
     return status;
 }
 
-/********************************************************************/
-/*********************** Misc BPM Operations ************************/
-/********************************************************************/
+/* Set a packed parameter from its channel parameters */
+void drvTimRx::publishPacked(int packed)
+{
+    const packedParams_t &params = packedParams[packed];
+    epicsUInt32 word = 0;
+    epicsUInt32 bit = 0;
+
+    for (int addr = 0; addr < params.numChannels; ++addr) {
+        bit = 0;
+        getUIntDigitalParam(addr, params.chan, &bit, 0x1);
+        word |= (bit & 0x1) << addr;
+    }
 
-/*
- * Miscellaneous functions that don't map easily
- * to our generic handlers get/setParam[32/Double]
- */
+    setUIntDigitalParam(params.packed, word, 0xFFFFFFFF);
+}
 
-asynStatus drvTimRx::setSi57xFreq(epicsUInt32 value, uint32_t *n1, uint32_t *hs_div, uint32_t *ReqLo, uint32_t *ReqHi)
+/* Refresh every packed parameter. Callers do the callbacks */
+void drvTimRx::publishPackedAll()
 {
-    int status = asynSuccess;
-    const char* functionName = "setSi57xFreq";
-    uint64_t fxtal = 114285000; // from Si57x datasheet
-    uint64_t fdco_min = 4850000000; // from Si57x datasheet
-    uint64_t fdco_max = 5670000000; // from Si57x datasheet
-    uint64_t fdco = 0;
-    uint64_t RFReq = 0;
-    uint32_t n1_max_val = 128;
-    uint32_t n1_min_val = 2;
-    uint32_t n1_step = 2;
-    const uint32_t hs_div_opt_size = 6;
-    uint32_t hs_div_val[hs_div_opt_size] = {7, 5, 3, 2, 1, 0};
-    uint32_t hs_div_opt[hs_div_opt_size] = {11, 9, 7, 6, 5, 4};
-
-    for (uint32_t i = 0; i < hs_div_opt_size; ++i) {
-        *hs_div = hs_div_val[i];
-        for (*n1 = n1_min_val; *n1 <= n1_max_val; *n1=*n1+n1_step) {
-            fdco = uint64_t(value)*uint64_t(hs_div_opt[i])*uint64_t(*n1);
-            if ((fdco >= fdco_min) && (fdco <= fdco_max)) {
-                break;
-            }
-        }
-        if ((fdco >= fdco_min) && (fdco <= fdco_max))
-            break;
+    for (size_t i = 0; i < packedParams.size(); ++i) {
+        publishPacked(i);
     }
+}
 
-    *n1 = *n1 - 1;
-    RFReq = uint64_t((double(fdco)/double(fxtal))*(1 << 28));
-    *ReqHi = uint32_t(RFReq >> 20);
-    *ReqLo = uint32_t(RFReq & 0xfffff);
+/* Return the oscillator a Si57x register parameter belongs to, or -1 */
+int drvTimRx::getSi57xOsc(int functionId) const
+{
+    for (int osc = 0; osc < si57xNumOsc; ++osc) {
+        if (functionId == si57xParams[osc].n1 ||
+                functionId == si57xParams[osc].hsDiv ||
+                functionId == si57xParams[osc].rfreqLo ||
+                functionId == si57xParams[osc].rfreqHi) {
+            return osc;
+        }
+    }
 
-    return (asynStatus)status;
+    return -1;
 }
 
-asynStatus drvTimRx::setRtmSi57xFreq(epicsUInt32 value, int addr)
+/* Store registers just read from or written to hardware and publish them,
+ * together with the frequency they result in. Must be called with the
+ * driver lock held */
+void drvTimRx::updateSi57xShadow(int osc, epicsUInt32 n1, epicsUInt32 hsDiv,
+        epicsUInt32 rfreqLo, epicsUInt32 rfreqHi)
 {
-    int err = HALCS_CLIENT_SUCCESS;
-    char service[SERVICE_NAME_SIZE];
-    int status = asynSuccess;
-    const char* functionName = "setRtmSi57xFreq";
-    epicsUInt32 RtmSi57xFreq = 0;
+    si57xShadow_t &shadow = si57xShadow[osc];
+    const si57xParams_t &params = si57xParams[osc];
+    epicsUInt32 freq = 0;
 
-    uint32_t n1, hs_div, ReqLo, ReqHi;
+    shadow.n1 = n1;
+    shadow.hsDiv = hsDiv;
+    shadow.rfreqLo = rfreqLo;
+    shadow.rfreqHi = rfreqHi;
+    epicsTimeGetCurrent(&shadow.updated);
+    shadow.valid = true;
 
-    setSi57xFreq(value, &n1, &hs_div, &ReqLo, &ReqHi);
+    functionsArgs_t functionArgs = {0};
+    functionArgs.argUInt32 = n1;
+    storeRegShadow(params.n1, 0, functionArgs);
+    functionArgs.argUInt32 = hsDiv;
+    storeRegShadow(params.hsDiv, 0, functionArgs);
+    functionArgs.argUInt32 = rfreqLo;
+    storeRegShadow(params.rfreqLo, 0, functionArgs);
+    functionArgs.argUInt32 = rfreqHi;
+    storeRegShadow(params.rfreqHi, 0, functionArgs);
+
+    setUIntDigitalParam(params.rfreqHi, rfreqHi, 0xFFFFFFFF);
+    setUIntDigitalParam(params.rfreqLo, rfreqLo, 0xFFFFFFFF);
+    setUIntDigitalParam(params.n1, n1, 0xFFFFFFFF);
+    setUIntDigitalParam(params.hsDiv, hsDiv, 0xFFFFFFFF);
+
+    getSi57xFreq(&freq, n1, hsDiv, rfreqLo, rfreqHi);
+    setUIntDigitalParam(params.freq, freq, 0xFFFFFFFF);
+    setParamStatus(params.freq, asynSuccess);
+}
 
-    /* Get correct service name*/
-    status = getFullServiceName (this->timRxNumber, addr, "LNLS_AFC_TIMING",
-            service, sizeof(service));
-    if (status) {
-        asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
-                "%s:%s: error calling getFullServiceName, status=%d\n",
-                driverName, functionName, status);
-        goto get_service_err;
-    }
+/* Read the Si57x registers of one oscillator from hardware into its
+ * shadow. On failure the shadow keeps its previous contents, so its age
+ * keeps growing. Must be called with the driver lock held */
+asynStatus drvTimRx::refreshSi57xShadow(int osc)
+{
+    asynStatus status = asynSuccess;
+    const si57xParams_t &params = si57xParams[osc];
+    const int regs[] = {params.n1, params.hsDiv, params.rfreqLo, params.rfreqHi};
+    epicsUInt32 values[ARRAY_SIZE(regs)];
+    functionsArgs_t functionArgs = {0};
 
-    err = afc_timing_set_rtm_n1        (timRxClient, service, n1);
-    err |= afc_timing_set_rtm_hs_div   (timRxClient, service, hs_div);
-    err |= afc_timing_set_rtm_rfreq_lo (timRxClient, service, ReqLo);
-    err |= afc_timing_set_rtm_rfreq_hi (timRxClient, service, ReqHi);
-    if (err != HALCS_CLIENT_SUCCESS) {
-        status = asynError;
-        goto set_AfcSi57xFreq_err;
+    for (size_t i = 0; i < ARRAY_SIZE(regs); ++i) {
+        functionArgs.argUInt32 = 0;
+        status = executeHwReadFunction(regs[i], 0, functionArgs);
+        if (status != asynSuccess) {
+            setParamStatus(params.freq, status);
+            return status;
+        }
+        values[i] = functionArgs.argUInt32;
     }
 
-    afc_timing_get_rtm_n1       (timRxClient, service, &n1);
-    afc_timing_get_rtm_hs_div   (timRxClient, service, &hs_div);
-    afc_timing_get_rtm_rfreq_lo (timRxClient, service, &ReqLo);
-    afc_timing_get_rtm_rfreq_hi (timRxClient, service, &ReqHi);
+    updateSi57xShadow(osc, values[0], values[1], values[2], values[3]);
+
+    return asynSuccess;
+}
 
-    setUIntDigitalParam(P_TimRxRtmRfreqHi,  ReqHi,  0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxRtmRfreqLo,  ReqLo,  0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxRtmN1,       n1,     0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxRtmHsDiv,    hs_div, 0xFFFFFFFF);
+/* Frequency of one oscillator, computed from its shadow. Hardware is only
+ * read if the shadow was never filled */
+asynStatus drvTimRx::getSi57xShadowFreq(int osc, epicsUInt32 *value)
+{
+    asynStatus status = asynSuccess;
+    const si57xShadow_t &shadow = si57xShadow[osc];
 
-set_AfcSi57xFreq_err:
-get_service_err:
-get_param_err:
-    return (asynStatus)status;
+    if (!shadow.valid) {
+        status = refreshSi57xShadow(osc);
+        if (status != asynSuccess) {
+            return status;
+        }
+    }
+
+    return getSi57xFreq(value, shadow.n1, shadow.hsDiv, shadow.rfreqLo,
+            shadow.rfreqHi);
 }
 
-asynStatus drvTimRx::setAfcSi57xFreq(epicsUInt32 value, int addr)
+/* Seconds since the shadow of one oscillator was last refreshed */
+asynStatus drvTimRx::getSi57xShadowAge(int osc, epicsFloat64 *value)
 {
-    int err = HALCS_CLIENT_SUCCESS;
-    char service[SERVICE_NAME_SIZE];
-    int status = asynSuccess;
-    const char* functionName = "setAfcSi57xFreq";
+    epicsTimeStamp now;
+    const si57xShadow_t &shadow = si57xShadow[osc];
 
-    uint32_t n1, hs_div, ReqLo, ReqHi;
+    if (!shadow.valid) {
+        return asynError;
+    }
 
-    setSi57xFreq(value, &n1, &hs_div, &ReqLo, &ReqHi);
+    epicsTimeGetCurrent(&now);
+    *value = epicsTimeDiffInSeconds(&now, &shadow.updated);
+    setDoubleParam(si57xParams[osc].age, *value);
 
-    /* Get correct service name*/
-    status = getFullServiceName (this->timRxNumber, addr, "LNLS_AFC_TIMING",
-            service, sizeof(service));
-    if (status) {
-        asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
-                "%s:%s: error calling getFullServiceName, status=%d\n",
-                driverName, functionName, status);
-        goto get_service_err;
+    return asynSuccess;
+}
+
+/********************************************************************/
+/*********************** Register Shadow ****************************/
+/********************************************************************/
+
+/*
+ * Read-through shadow of the hardware registers. Reads of a parameter
+ * within its TTL of the last hardware access are served from memory,
+ * saving a HALCS round trip
+ */
+
+void drvTimRx::initRegShadow()
+{
+    regShadow.assign(NUM_PARAMS*MAX_ADDR, regShadow_t());
+    regIoSeq.assign(NUM_PARAMS*MAX_ADDR, 0);
+    regIoDone.assign(NUM_PARAMS*MAX_ADDR, 0);
+    regShadowTtl.assign(NUM_PARAMS, -1.0);
+}
+
+/* Force the next read of every parameter to go to hardware. Must be
+ * called with the driver lock held */
+void drvTimRx::invalidateRegShadow()
+{
+    for (size_t i = 0; i < regShadow.size(); ++i) {
+        regShadow[i].valid = false;
     }
+}
 
-    err = afc_timing_set_afc_n1        (timRxClient, service, n1);
-    err |= afc_timing_set_afc_hs_div   (timRxClient, service, hs_div);
-    err |= afc_timing_set_afc_rfreq_lo (timRxClient, service, ReqLo);
-    err |= afc_timing_set_afc_rfreq_hi (timRxClient, service, ReqHi);
-    if (err != HALCS_CLIENT_SUCCESS) {
-        status = asynError;
-        goto set_AfcSi57xFreq_err;
+/* Serve a read from the shadow if the value is fresh enough. Returns false
+ * if hardware must be read. Must be called with the driver lock held */
+bool drvTimRx::readRegShadow(int functionId, int addr, functionsArgs_t &functionArgs)
+{
+    epicsFloat64 ttl = 0.0;
+    epicsTimeStamp now;
+    int index = functionId - FIRST_COMMAND;
+
+    if (getHwFunc(functionId) == NULL || regShadow.empty()) {
+        return false;
     }
 
-    afc_timing_get_afc_n1       (timRxClient, service, &n1);
-    afc_timing_get_afc_hs_div   (timRxClient, service, &hs_div);
-    afc_timing_get_afc_rfreq_lo (timRxClient, service, &ReqLo);
-    afc_timing_get_afc_rfreq_hi (timRxClient, service, &ReqHi);
+    ttl = regShadowTtl[index];
+    if (ttl < 0.0) {
+        if (getParamFlags(functionId) & TIM_RX_PARAM_VOLATILE) {
+            return false;
+        }
+        getDoubleParam(P_TimRxShadowTtl, &ttl);
+    }
+    if (ttl <= 0.0) {
+        return false;
+    }
 
-    setUIntDigitalParam(P_TimRxAfcRfreqHi,  ReqHi,  0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxAfcRfreqLo,  ReqLo,  0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxAfcN1,       n1,     0xFFFFFFFF);
-    setUIntDigitalParam(P_TimRxAfcHsDiv,    hs_div, 0xFFFFFFFF);
+    const regShadow_t &shadow = regShadow[index*MAX_ADDR + addr];
+    epicsTimeGetCurrent(&now);
+    if (shadow.valid && epicsTimeDiffInSeconds(&now, &shadow.updated) < ttl) {
+        functionArgs = shadow.value;
+        ++regShadowHits;
+        setUIntDigitalParam(P_TimRxShadowHits, regShadowHits, 0xFFFFFFFF);
+        return true;
+    }
 
-set_AfcSi57xFreq_err:
-get_service_err:
-    return (asynStatus)status;
+    ++regShadowMisses;
+    setUIntDigitalParam(P_TimRxShadowMisses, regShadowMisses, 0xFFFFFFFF);
+    return false;
 }
 
-asynStatus drvTimRx::getSi57xFreq(epicsUInt32 *value, uint32_t n1, uint32_t hs_div, uint32_t ReqLo, uint32_t ReqHi)
+/* Record a value just read from or written to hardware. Must be called
+ * with the driver lock held */
+void drvTimRx::storeRegShadow(int functionId, int addr,
+        const functionsArgs_t &functionArgs)
 {
-    int status = asynSuccess;
-    const char* functionName = "getSi57xFreq";
-    double fxtal = 114285000; // from Si57x datasheet
-    double RFReq = double((uint64_t(ReqHi)<< 20) + uint64_t(ReqLo))/double(1 << 28);
-    double fdco = RFReq * fxtal;
-    const uint32_t hs_div_opt_size = 6;
-    uint32_t hs_div_val[hs_div_opt_size] = {7, 5, 3, 2, 1, 0};
-    uint32_t hs_div_opt[hs_div_opt_size] = {11, 9, 7, 6, 5, 4};
-    for (uint32_t i = 0; i < hs_div_opt_size; ++i) {
-        if (hs_div == hs_div_val[i]) {
-            *value = uint32_t(fdco/double((n1+1)*hs_div_opt[i]));
-            break;
+    if (regShadow.empty()) {
+        return;
+    }
+
+    int slot = (functionId - FIRST_COMMAND)*MAX_ADDR + addr;
+    regShadow_t &shadow = regShadow[slot];
+
+    /* A later HALCS call on the register has already been stored */
+    if (hwIoSlot == slot) {
+        hwIoSlot = -1;
+        if (hwIoSeq - shadow.ioSeq < 0) {
+            return;
         }
+        shadow.ioSeq = hwIoSeq;
     }
 
-    return (asynStatus)status;
+    shadow.value = functionArgs;
+    epicsTimeGetCurrent(&shadow.updated);
+    shadow.valid = true;
 }
 
-asynStatus drvTimRx::getRtmSi57xFreq(epicsUInt32 *value, int addr)
+/* Check if a write can be skipped, as the shadow holds a value read from
+ * or written to hardware that equals the one to be written. Another HALCS
+ * client or a board reset may change a register behind our back, so only
+ * a value seen in hardware within TIM_RX_WRITE_ELIDE_AGE is trusted, as
+ * the one reapplyConfig reads just before writing. The TTL does not apply
+ * here. Must be called with the driver lock held */
+bool drvTimRx::elideWrite(int functionId, int addr, const functionsArgs_t &functionArgs,
+        asynParamType type)
 {
-    int err = HALCS_CLIENT_SUCCESS;
-    char service[SERVICE_NAME_SIZE];
-    int status = asynSuccess;
-    const char* functionName = "getRtmSi57xFreq";
+    epicsUInt32 elide = 0;
+    epicsFloat64 maxAge = 0.0;
+    epicsTimeStamp now;
+    bool equal = false;
+
+    if (regShadow.empty() || getHwFunc(functionId) == NULL ||
+            (getParamFlags(functionId) &
+                (TIM_RX_PARAM_VOLATILE | TIM_RX_PARAM_SIDE_EFFECT))) {
+        return false;
+    }
 
-    uint32_t n1, hs_div, ReqLo, ReqHi;
+    getUIntDigitalParam(P_TimRxWriteElide, &elide, 0xFFFFFFFF);
+    if (!elide) {
+        return false;
+    }
 
-    /* Get correct service name*/
-    status = getFullServiceName (this->timRxNumber, addr, "LNLS_AFC_TIMING",
-            service, sizeof(service));
-    if (status) {
-        asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
-                "%s:%s: error calling getFullServiceName, status=%d\n",
-                driverName, functionName, status);
-        goto get_service_err;
+    const regShadow_t &shadow = regShadow[(functionId - FIRST_COMMAND)*MAX_ADDR + addr];
+    getDoubleParam(P_TimRxWriteElideAge, &maxAge);
+    epicsTimeGetCurrent(&now);
+    if (!shadow.valid || epicsTimeDiffInSeconds(&now, &shadow.updated) >= maxAge) {
+        return false;
     }
 
-    afc_timing_get_rtm_n1       (timRxClient, service, &n1);
-    afc_timing_get_rtm_hs_div   (timRxClient, service, &hs_div);
-    afc_timing_get_rtm_rfreq_lo (timRxClient, service, &ReqLo);
-    afc_timing_get_rtm_rfreq_hi (timRxClient, service, &ReqHi);
+    if (type == asynParamFloat64) {
+        equal = (shadow.value.argFloat64 == functionArgs.argFloat64);
+    }
+    else {
+        equal = (shadow.value.argUInt32 == functionArgs.argUInt32);
+    }
 
-    getSi57xFreq(value, n1, hs_div, ReqLo, ReqHi);
+    if (equal) {
+        ++writeElided;
+        setUIntDigitalParam(P_TimRxWriteElided, writeElided, 0xFFFFFFFF);
+    }
 
-get_service_err:
-    return (asynStatus)status;
+    return equal;
 }
 
-asynStatus drvTimRx::getAfcSi57xFreq(epicsUInt32 *value, int addr)
+asynStatus drvTimRx::setShadowTtl(const char *drvInfo, epicsFloat64 ttl)
 {
-    int err = HALCS_CLIENT_SUCCESS;
-    char service[SERVICE_NAME_SIZE];
-    int status = asynSuccess;
-    const char* functionName = "getAfcSi57xFreq";
-
-    uint32_t n1, hs_div, ReqLo, ReqHi;
+    asynStatus status = asynSuccess;
+    const char *functionName = "setShadowTtl";
+    int functionId = -1;
 
-    /* Get correct service name*/
-    status = getFullServiceName (this->timRxNumber, addr, "LNLS_AFC_TIMING",
-            service, sizeof(service));
-    if (status) {
+    status = findParam(drvInfo, &functionId);
+    if (status != asynSuccess || functionId < FIRST_COMMAND ||
+            functionId > LAST_COMMAND) {
         asynPrint(this->pasynUserSelf, ASYN_TRACE_ERROR,
-                "%s:%s: error calling getFullServiceName, status=%d\n",
-                driverName, functionName, status);
-        goto get_service_err;
+                "%s:%s: unknown parameter %s\n",
+                driverName, functionName, drvInfo);
+        return asynError;
     }
 
-    afc_timing_get_afc_n1       (timRxClient, service, &n1);
-    afc_timing_get_afc_hs_div   (timRxClient, service, &hs_div);
-    afc_timing_get_afc_rfreq_lo (timRxClient, service, &ReqLo);
-    afc_timing_get_afc_rfreq_hi (timRxClient, service, &ReqHi);
-
-    getSi57xFreq(value, n1, hs_div, ReqLo, ReqHi);
+    lock();
+    regShadowTtl[functionId - FIRST_COMMAND] = ttl;
+    unlock();
 
-get_service_err:
-    return (asynStatus)status;
+    return asynSuccess;
 }
 
 /* Configuration routine.  Called directly, or from the iocsh function below */
@@ -1379,11 +4849,147 @@ extern "C" {
 
     /** EPICS iocsh callable function to call constructor for the drvTimRx class.
      * \param[in] portName The name of the asyn port driver to be created.
-     * \param[in] endpoint The address device string */
+     * \param[in] endpoint The address device string
+     * \param[in] numWorkers Number of I/O workers, each with its own
+     * HALCS client. 0 takes the default of 1 */
     int drvTimRxConfigure(const char *portName, const char *endpoint,
-            int timRxNumber, int verbose, int timeout)
+            int timRxNumber, int verbose, int timeout, int numWorkers)
+    {
+        drvTimRx *pDrv = new drvTimRx(portName, endpoint, timRxNumber, verbose,
+                timeout, numWorkers);
+        /* Have the hardware configuration read before iocInit */
+        pDrv->waitFirstConnect(TIM_RX_CONN_STARTUP_WAIT);
+        return(asynSuccess);
+    }
+
+    /** EPICS iocsh callable function to serve several receivers from this IOC.
+     * One drvTimRx port is created for each receiver, all of them sharing the
+     * HALCS client of their board and the poll scheduler.
+     * \param[in] portPrefix Receiver N is served by port <portPrefix>N.
+     * \param[in] endpoint The address device string
+     * \param[in] timRxList Receiver numbers, as in "1-4,7,9-24"
+     * \param[in] numWorkers Number of I/O workers of each port */
+    int drvTimRxConfigureCrate(const char *portPrefix, const char *endpoint,
+            const char *timRxList, int verbose, int timeout, int numWorkers)
+    {
+        bool selected[TIM_RX_NUMBER_MAX+1] = {false};
+        drvTimRx *pDrvs[TIM_RX_NUMBER_MAX+1] = {NULL};
+        epicsTimeStamp start;
+        epicsTimeStamp now;
+        epicsFloat64 waited = 0.0;
+        char portName[64];
+        const char *p = timRxList;
+        char *end = NULL;
+        long first = 0;
+        long last = 0;
+
+        if (portPrefix == NULL || timRxList == NULL) {
+            printf("drvTimRxConfigureCrate: portPrefix and timRxList are required\n");
+            return(asynError);
+        }
+
+        /* Parse the whole list before creating any port */
+        while (*p != '\0') {
+            first = strtol(p, &end, 10);
+            if (end == p) {
+                goto parse_err;
+            }
+            last = first;
+            p = end;
+            if (*p == '-') {
+                ++p;
+                last = strtol(p, &end, 10);
+                if (end == p) {
+                    goto parse_err;
+                }
+                p = end;
+            }
+            if (first < TIM_RX_NUMBER_MIN || last > TIM_RX_NUMBER_MAX || first > last) {
+                goto parse_err;
+            }
+            for (long n = first; n <= last; ++n) {
+                selected[n] = true;
+            }
+            if (*p == ',') {
+                ++p;
+            }
+            else if (*p != '\0') {
+                goto parse_err;
+            }
+        }
+
+        for (int n = TIM_RX_NUMBER_MIN; n <= TIM_RX_NUMBER_MAX; ++n) {
+            if (selected[n]) {
+                epicsSnprintf(portName, sizeof(portName), "%s%d", portPrefix, n);
+                pDrvs[n] = new drvTimRx(portName, endpoint, n, verbose, timeout,
+                        numWorkers);
+            }
+        }
+
+        /* All receivers are reached in parallel, so the wait is bounded
+         * once for the whole crate */
+        epicsTimeGetCurrent(&start);
+        for (int n = TIM_RX_NUMBER_MIN; n <= TIM_RX_NUMBER_MAX; ++n) {
+            if (pDrvs[n] != NULL) {
+                epicsTimeGetCurrent(&now);
+                waited = epicsTimeDiffInSeconds(&now, &start);
+                pDrvs[n]->waitFirstConnect((waited < TIM_RX_CONN_STARTUP_WAIT)?
+                        TIM_RX_CONN_STARTUP_WAIT - waited : 0.0);
+            }
+        }
+        return(asynSuccess);
+
+parse_err:
+        printf("drvTimRxConfigureCrate: invalid receiver list \"%s\". "
+                "Receivers must be between %d and %d\n", timRxList,
+                TIM_RX_NUMBER_MIN, TIM_RX_NUMBER_MAX);
+        return(asynError);
+    }
+
+    /** EPICS iocsh callable function to set the register shadow TTL of
+     * one parameter of a drvTimRx port.
+     * \param[in] portName The name of the drvTimRx port.
+     * \param[in] drvInfo The drvInfo string of the parameter, as in TIM_RX_AMC_EVT.
+     * \param[in] ttl TTL in seconds. Zero always reads hardware, negative
+     * reverts to the TTL set by the TIM_RX_SHADOW_TTL parameter */
+    int drvTimRxSetShadowTtl(const char *portName, const char *drvInfo, double ttl)
+    {
+        drvTimRx *pDrv = NULL;
+
+        if (portName == NULL || drvInfo == NULL) {
+            printf("drvTimRxSetShadowTtl: portName and drvInfo are required\n");
+            return(asynError);
+        }
+
+        pDrv = (drvTimRx *) findAsynPortDriver(portName);
+        if (pDrv == NULL) {
+            printf("drvTimRxSetShadowTtl: port %s not found\n", portName);
+            return(asynError);
+        }
+
+        return(pDrv->setShadowTtl(drvInfo, ttl));
+    }
+
+    /** EPICS iocsh callable function to print the last entries of the
+     * hardware access trace of a drvTimRx port.
+     * \param[in] portName The name of the drvTimRx port.
+     * \param[in] num Number of entries, up to the ring size */
+    int drvTimRxTraceDump(const char *portName, int num)
     {
-        new drvTimRx(portName, endpoint, timRxNumber, verbose, timeout);
+        drvTimRx *pDrv = NULL;
+
+        if (portName == NULL) {
+            printf("drvTimRxTraceDump: portName is required\n");
+            return(asynError);
+        }
+
+        pDrv = (drvTimRx *) findAsynPortDriver(portName);
+        if (pDrv == NULL) {
+            printf("drvTimRxTraceDump: port %s not found\n", portName);
+            return(asynError);
+        }
+
+        pDrv->dumpTrace((num > 0)? num : TIM_RX_TRACE_SIZE);
         return(asynSuccess);
     }
 
@@ -1393,21 +4999,67 @@ extern "C" {
     static const iocshArg initArg2 = { "timRxNumber", iocshArgInt};
     static const iocshArg initArg3 = { "verbose", iocshArgInt};
     static const iocshArg initArg4 = { "timeout", iocshArgInt};
+    static const iocshArg initArg5 = { "numWorkers", iocshArgInt};
     static const iocshArg * const initArgs[] = {&initArg0,
         &initArg1,
         &initArg2,
         &initArg3,
-        &initArg4};
-    static const iocshFuncDef initFuncDef = {"drvTimRxConfigure",5,initArgs};
+        &initArg4,
+        &initArg5};
+    static const iocshFuncDef initFuncDef = {"drvTimRxConfigure",6,initArgs};
     static void initCallFunc(const iocshArgBuf *args)
     {
         drvTimRxConfigure(args[0].sval, args[1].sval, args[2].ival,
-                args[3].ival, args[4].ival);
+                args[3].ival, args[4].ival, args[5].ival);
+    }
+
+    static const iocshArg initCrateArg0 = { "portPrefix", iocshArgString};
+    static const iocshArg initCrateArg1 = { "endpoint", iocshArgString};
+    static const iocshArg initCrateArg2 = { "timRxList", iocshArgString};
+    static const iocshArg initCrateArg3 = { "verbose", iocshArgInt};
+    static const iocshArg initCrateArg4 = { "timeout", iocshArgInt};
+    static const iocshArg initCrateArg5 = { "numWorkers", iocshArgInt};
+    static const iocshArg * const initCrateArgs[] = {&initCrateArg0,
+        &initCrateArg1,
+        &initCrateArg2,
+        &initCrateArg3,
+        &initCrateArg4,
+        &initCrateArg5};
+    static const iocshFuncDef initCrateFuncDef = {"drvTimRxConfigureCrate",6,initCrateArgs};
+    static void initCrateCallFunc(const iocshArgBuf *args)
+    {
+        drvTimRxConfigureCrate(args[0].sval, args[1].sval, args[2].sval,
+                args[3].ival, args[4].ival, args[5].ival);
+    }
+
+    static const iocshArg shadowTtlArg0 = { "portName", iocshArgString};
+    static const iocshArg shadowTtlArg1 = { "drvInfo", iocshArgString};
+    static const iocshArg shadowTtlArg2 = { "ttl", iocshArgDouble};
+    static const iocshArg * const shadowTtlArgs[] = {&shadowTtlArg0,
+        &shadowTtlArg1,
+        &shadowTtlArg2};
+    static const iocshFuncDef shadowTtlFuncDef = {"drvTimRxSetShadowTtl",3,shadowTtlArgs};
+    static void shadowTtlCallFunc(const iocshArgBuf *args)
+    {
+        drvTimRxSetShadowTtl(args[0].sval, args[1].sval, args[2].dval);
+    }
+
+    static const iocshArg traceDumpArg0 = { "portName", iocshArgString};
+    static const iocshArg traceDumpArg1 = { "num", iocshArgInt};
+    static const iocshArg * const traceDumpArgs[] = {&traceDumpArg0,
+        &traceDumpArg1};
+    static const iocshFuncDef traceDumpFuncDef = {"drvTimRxTraceDump",2,traceDumpArgs};
+    static void traceDumpCallFunc(const iocshArgBuf *args)
+    {
+        drvTimRxTraceDump(args[0].sval, args[1].ival);
     }
 
     void drvTimRxRegister(void)
     {
         iocshRegister(&initFuncDef,initCallFunc);
+        iocshRegister(&initCrateFuncDef,initCrateCallFunc);
+        iocshRegister(&shadowTtlFuncDef,shadowTtlCallFunc);
+        iocshRegister(&traceDumpFuncDef,traceDumpCallFunc);
     }
 
     epicsExportRegistrar(drvTimRxRegister);
@@ -9,16 +9,13 @@
 #include "asynPortDriver.h"
 #include <epicsExit.h>
 #include <epicsMutex.h>
+#include <epicsEvent.h>
+#include <epicsTime.h>
 /* Third-party libraries */
-#include <unordered_map>
+#include <vector>
 #include <halcs_client.h>
 
-// any implementation for non c++-17 compilers
-#include "any.hpp"
-
-using linb::any;
-using linb::any_cast;
-using linb::bad_any_cast;
+#include "Si57x.h"
 
 #define ARRAY_SIZE(ARRAY)           (sizeof(ARRAY)/sizeof((ARRAY)[0]))
 
@@ -34,6 +31,126 @@ using linb::bad_any_cast;
 #define MAX_AMC_TRIGGER_CH          8
 #define MAX_FMC1_TRIGGER_CH         5
 #define MAX_FMC2_TRIGGER_CH         5
+#define MAX_TRIGGER_CH              (MAX_AMC_TRIGGER_CH + MAX_FMC1_TRIGGER_CH + \
+                                     MAX_FMC2_TRIGGER_CH)
+
+/* Default status poller period, in seconds */
+#define TIM_RX_STATUS_POLL_PERIOD_DFLT      1.0
+/* Default event counter poller period, in seconds */
+#define TIM_RX_CNT_POLL_PERIOD_DFLT         0.5
+/* Default write coalescing holdoff, in seconds. Zero writes through */
+#define TIM_RX_WRITE_HOLDOFF_DFLT           0.0
+/* Default Si57x shadow refresh period, in seconds */
+#define TIM_RX_SI57X_POLL_PERIOD_DFLT       10.0
+/* Default register shadow TTL, in seconds. Zero reads through */
+#define TIM_RX_SHADOW_TTL_DFLT              0.0
+/* Default write elision mode. Non-zero skips writes of the value already
+ * in hardware. Off unless enabled with WriteElide-Sel, as a skipped write
+ * never reaches the FPGA */
+#define TIM_RX_WRITE_ELIDE_DFLT             0
+/* Default age limit of the shadow value a write is elided against, in
+ * seconds. Covers the read reapplyConfig does just before writing and the
+ * startup snapshot up to the PINI writes */
+#define TIM_RX_WRITE_ELIDE_AGE_DFLT         5.0
+/* Bounds of the wait between reconnection attempts, in seconds. The wait
+ * doubles after each failed attempt */
+#define TIM_RX_CONN_BACKOFF_MIN             0.05
+#define TIM_RX_CONN_BACKOFF_MAX             0.5
+/* Longest wait at configuration for the first connection attempt, which
+ * reads the hardware configuration before iocInit, in seconds */
+#define TIM_RX_CONN_STARTUP_WAIT            10.0
+/* Default number of consecutive HALCS timeouts that trip the circuit
+ * breaker */
+#define TIM_RX_BREAKER_THRESHOLD_DFLT       3
+/* Default trigger rate averaging window, in seconds. 0 publishes the
+ * rate of the last counter sweep alone */
+#define TIM_RX_RATE_WINDOW_DFLT             1.0
+/* Release the driver lock during HALCS calls by default */
+#define TIM_RX_HW_UNLOCK_DFLT               1
+/* Number of register lock stripes */
+#define TIM_RX_REG_LOCK_STRIPES             16
+/* Maximum number of I/O workers. Registers are assigned to workers by
+ * stripe, so more workers than stripes would never run */
+#define TIM_RX_MAX_WORKERS                  8
+/* Default FPGA clock, in Hz, until the EVG value arrives */
+#define TIM_RX_FPGA_CLK_DFLT                124914500.0
+
+/* Number of entries of the hardware access trace ring. Must be a power
+ * of 2 */
+#define TIM_RX_TRACE_SIZE                   1024
+/* Words of one entry in the trace dump waveform */
+#define TIM_RX_TRACE_DUMP_WORDS             9
+
+/* Number of bins of the execution lane histograms */
+#define TIM_RX_HIST_NUM_BINS                20
+/* Upper bound of the first wait time bin, in seconds. Each next bin
+ * doubles it */
+#define TIM_RX_HIST_WAIT_BASE               10e-6
+
+/* HALCS clients shared by every receiver of a board served by this IOC.
+ * There is one client per execution lane, so periodic sweeps never hold
+ * up setpoint writes. Calls through a client must hold its lock. The
+ * waiter counts are the lane queue depths */
+typedef struct {
+    char *endpoint;
+    int board;
+    int refCount;
+    /* Set once a receiver lost its board through these clients. A broken
+     * entry is out of the shared list, so the next acquire creates new
+     * clients, and it is destroyed once its last user releases it */
+    int broken;
+    /* Port lane: setpoint writes and on-demand reads */
+    halcs_client_t *client;
+    epicsMutexId lock;
+    int lockWaiters;
+    /* Poll lane: periodic sweeps */
+    halcs_client_t *pollClient;
+    epicsMutexId pollLock;
+    int pollLockWaiters;
+    /* Worker lanes: one client per write worker. Not created with a
+     * single worker, which uses the port lane. Sized for the receiver of
+     * the board with the most workers and only ever grows */
+    int numWorkers;
+    halcs_client_t *workerClients[TIM_RX_MAX_WORKERS];
+    epicsMutexId workerLocks[TIM_RX_MAX_WORKERS];
+    int workerLockWaiters[TIM_RX_MAX_WORKERS];
+} timRxSharedClient_t;
+
+/* Execution lanes */
+typedef enum {
+    lanePort = 0,
+    lanePoll,
+    numLanes
+} lane_e;
+
+/* Histograms of one execution lane. waitHist bin 0 counts waits for the
+ * lane client below TIM_RX_HIST_WAIT_BASE and bin k waits below
+ * TIM_RX_HIST_WAIT_BASE*2^k. depthHist bin k counts requests that found
+ * k others waiting. The last bins also count everything above them */
+typedef struct {
+    epicsInt32 waitHist[TIM_RX_HIST_NUM_BINS];
+    epicsInt32 depthHist[TIM_RX_HIST_NUM_BINS];
+} laneStats_t;
+
+/* Operations of the HALCS call latency statistics */
+typedef enum {
+    latOpRead = 0,
+    latOpWrite,
+    /* Si57x frequency setting, all of its register writes and readbacks */
+    latOpSi57x,
+    latNumOps
+} latOp_e;
+
+/* HALCS call latency of one (function, operation). hist has the bins of
+ * the lane wait time histograms. errors counts timeouts as well. Only
+ * updated with atomic operations */
+typedef struct {
+    int hist[TIM_RX_HIST_NUM_BINS];
+    int errors;
+    int timeouts;
+    /* Longest call, in nanoseconds */
+    int maxNs;
+} latStats_t;
 
 /* TIM_RX Mappping structure */
 typedef struct {
@@ -90,73 +207,282 @@ typedef struct {
     };
 } functionsArgs_t;
 
-/* Forward declaration as struct functionsAny_t needs it */
-class drvTimRx;
+/* Kind of hardware function held by functionsHw_t */
+typedef enum {
+    functionsHwNone = 0,
+    functionsHwInt32,
+    functionsHwInt32Chan,
+    functionsHwFloat64
+} functionsHwType_e;
 
-/* Idea based on https://stackoverflow.com/questions/15102139/boostany-and-templates*/
+/* Statically typed hardware function. Tagged union of the dispatch tables
+ * above, so it can live in a constant table without any heap storage */
+struct functionsHw_t {
+    functionsHwType_e type;
+    union {
+        functionsInt32_t int32;
+        functionsInt32Chan_t int32Chan;
+        functionsFloat64_t float64;
+    };
 
-/* Generic Function Structure for "any" function pointer */
-struct functionsAny_t {
-    template<typename T>
-        functionsAny_t(T const& functionFp) :
-            _functionFp(functionFp),
-            _executeHwReadFunction(&functionsAny_t::executeHwReadFunction<T>),
-            _executeHwWriteFunction(&functionsAny_t::executeHwWriteFunction<T>),
-            _getServiceNameFromFunc(&functionsAny_t::getServiceNameFromFunc<T>) {}
+    constexpr functionsHw_t() :
+        type(functionsHwNone), int32{NULL, NULL, NULL} {}
+    constexpr functionsHw_t(functionsInt32_t func) :
+        type(functionsHwInt32), int32(func) {}
+    constexpr functionsHw_t(functionsInt32Chan_t func) :
+        type(functionsHwInt32Chan), int32Chan(func) {}
+    constexpr functionsHw_t(functionsFloat64_t func) :
+        type(functionsHwFloat64), float64(func) {}
 
-    asynStatus executeHwRead(const drvTimRx& drvTimRx, char *service,
-        int addr, functionsArgs_t &functionParam)
+    bool hasWrite() const
     {
-        return (this->*_executeHwReadFunction)(drvTimRx, _functionFp,
-                service, addr, functionParam);
+        switch (type) {
+            case functionsHwInt32:
+                return int32.write != NULL;
+            case functionsHwInt32Chan:
+                return int32Chan.write != NULL;
+            case functionsHwFloat64:
+                return float64.write != NULL;
+            default:
+                return false;
+        }
     }
 
-    asynStatus executeHwWrite(const drvTimRx& drvTimRx, char *service,
-        int addr, functionsArgs_t &functionParam)
+    const char *getServiceName() const
     {
-        return (this->*_executeHwWriteFunction)(drvTimRx, _functionFp,
-                service, addr, functionParam);
+        switch (type) {
+            case functionsHwInt32:
+                return int32.serviceName;
+            case functionsHwInt32Chan:
+                return int32Chan.serviceName;
+            case functionsHwFloat64:
+                return float64.serviceName;
+            default:
+                return NULL;
+        }
     }
+};
 
-    const char *getServiceName(const drvTimRx& drvTimRx)
-    {
-        return (this->*_getServiceNameFromFunc)(drvTimRx, _functionFp);
-    }
+/* Circuit breaker states */
+typedef enum {
+    breakerClosed = 0,
+    /* HALCS calls fail right away */
+    breakerOpen,
+    /* HALCS calls fail right away, a probe is in flight */
+    breakerHalfOpen
+} breakerState_e;
 
-private:
-    any _functionFp;
-    /* Read template function for Hw execution */
-    typedef asynStatus (functionsAny_t::*executeHwReadFunctionFp)
-        (const drvTimRx& drvTimRx, const any& functionFp,
-         char *service, int addr, functionsArgs_t &functionParam);
-    executeHwReadFunctionFp _executeHwReadFunction;
-    /* Write template function for Hw execution */
-    typedef asynStatus (functionsAny_t::*executeHwWriteFunctionFp)
-        (const drvTimRx& drvTimRx, const any& functionFp,
-         char *service, int addr, functionsArgs_t &functionParam);
-    executeHwWriteFunctionFp _executeHwWriteFunction;
-    /* Service name utilities */
-    typedef const char * (functionsAny_t::*getServiceNameFromFuncFp)
-        (const drvTimRx& drvTimRx, const any& functionFp) const;
-    getServiceNameFromFuncFp _getServiceNameFromFunc;
-
-    /* Read function for Hw execution */
-    template<typename T>
-    asynStatus executeHwReadFunction(const drvTimRx& drvTimRx,
-            const any& functionFp, char *service, int addr,
-            functionsArgs_t &functionParam);
-
-    /* Write function for Hw execution */
-    template<typename T>
-    asynStatus executeHwWriteFunction(const drvTimRx& drvTimRx,
-            const any& functionFp, char *service, int addr,
-            functionsArgs_t &functionParam);
-
-    /* Service name utilities */
-    template<typename T>
-    const char *getServiceNameFromFunc(const drvTimRx& drvTimRx,
-            const any& functionFp) const;
-};
+/* Si57x oscillators */
+typedef enum {
+    si57xRtm = 0,
+    si57xAfc,
+    si57xNumOsc
+} si57xOsc_e;
+
+/* Parameters of one Si57x oscillator */
+typedef struct {
+    int freq;
+    int n1;
+    int hsDiv;
+    int rfreqLo;
+    int rfreqHi;
+    int age;
+    int freqErr;
+} si57xParams_t;
+
+/* Thread waiting for its turn on a register, see waitRegTurn */
+typedef struct {
+    int slot;
+    int ticket;
+    epicsEventId event;
+} regTurnWaiter_t;
+
+/* One HALCS call in progress, see beginHwAccess */
+typedef struct {
+    /* Set if the driver lock was released for the call */
+    bool unlocked;
+    int slot;
+    int ioSeq;
+    /* Trace lane, see traceEntry_t */
+    int lane;
+    /* Set by doExecuteHw*Function once HALCS was called, with its outcome */
+    bool called;
+    halcs_client_err_e err;
+    timRxSharedClient_t *sharedClient;
+    halcs_client_t *client;
+    epicsMutexId clientLock;
+    int *clientLockWaiters;
+    epicsMutexId stripe;
+    epicsFloat64 wait;
+    int depth;
+} hwAccess_t;
+
+/* Hardware access trace entry. seq is 0 while the entry is being written
+ * and the number of the access plus 1 once it is complete. lane is an
+ * execution lane, or numLanes plus the index of a write worker */
+typedef struct {
+    size_t seq;
+    int functionId;
+    int addr;
+    int write;
+    int lane;
+    functionsArgs_t value;
+    epicsTimeStamp start;
+    epicsTimeStamp end;
+    int err;
+} traceEntry_t;
+
+/* Trigger channel times published in microseconds. The hardware holds
+ * them in FPGA clock ticks */
+typedef enum {
+    trigTimeAmcDly = 0,
+    trigTimeAmcWdt,
+    trigTimeFmc1Dly,
+    trigTimeFmc1Wdt,
+    trigTimeFmc2Dly,
+    trigTimeFmc2Wdt,
+    trigTimeNum
+} trigTime_e;
+
+/* Parameters of one trigger channel time */
+typedef struct {
+    /* Ticks, mapped to hardware */
+    int raw;
+    /* Microseconds */
+    int eu;
+    int numChannels;
+} trigTimeParams_t;
+
+/* Parameters of the latency summary of one operation */
+typedef struct {
+    int hist;
+    int p50;
+    int p99;
+    int max;
+    int errors;
+    int timeouts;
+} latParams_t;
+
+/* Parameters of one packed trigger attribute. Bit n of packed is the
+ * single-bit chan parameter of channel n */
+typedef struct {
+    int packed;
+    int chan;
+    int numChannels;
+} packedParams_t;
+
+/* Si57x register shadow, one per oscillator. The frequency readback is
+ * computed from it instead of reading the registers from hardware */
+typedef struct {
+    bool valid;
+    epicsUInt32 n1;
+    epicsUInt32 hsDiv;
+    epicsUInt32 rfreqLo;
+    epicsUInt32 rfreqHi;
+    /* Time the registers were last read from or written to hardware */
+    epicsTimeStamp updated;
+} si57xShadow_t;
+
+/* Forward declaration as struct paramDesc_t needs it */
+class drvTimRx;
+
+/* Parameter registry flags */
+/* Writes may be held by the coalescing stage, only the last value
+ * within the holdoff reaches hardware */
+#define TIM_RX_PARAM_COALESCE               0x1
+/* Register is changed by the hardware itself. Reads are only served from
+ * the register shadow if a TTL was set for the parameter explicitly */
+#define TIM_RX_PARAM_VOLATILE               0x2
+/* Writing the register acts on the hardware even if the value does not
+ * change, so writes are never elided */
+#define TIM_RX_PARAM_SIDE_EFFECT            0x4
+
+/* Parameter registry entry. A single table of these drives parameter
+ * creation, the hardware function mapping and the initial values */
+typedef struct {
+    const char *name;
+    asynParamType type;
+    int drvTimRx::*index;
+    /* Number of addresses (channels) that get an initial value */
+    int numAddr;
+    functionsHw_t hwFunc;
+    /* TIM_RX_PARAM_* flags */
+    unsigned flags;
+} paramDesc_t;
+
+/* Write held by the coalescing stage, one per (function, addr) */
+typedef struct {
+    bool pending;
+    /* Union of the masks of the writes merged in this one */
+    epicsUInt32 mask;
+    /* Time the first of the merged writes was queued */
+    epicsTimeStamp queued;
+} pendingWrite_t;
+
+/* One register read of a sweep, see pollReadBatch */
+typedef struct {
+    int functionId;
+    int addr;
+    epicsUInt32 value;
+    asynStatus status;
+    /* Set once HALCS was called, with its outcome */
+    bool called;
+    halcs_client_err_e err;
+    epicsFloat64 wait;
+    int depth;
+    epicsTimeStamp time;
+} pollRead_t;
+
+/* Worker. Flushes the held writes and runs the sweep reads of the
+ * registers assigned to it, through its own HALCS client */
+typedef struct {
+    drvTimRx *driver;
+    int index;
+    /* Held writes assigned to this worker, in queueing order. Protected
+     * by the driver lock */
+    std::vector<int> pendingWriteList;
+    /* Sweep reads assigned to this worker. Protected by the driver lock */
+    std::vector<pollRead_t *> pollReadList;
+    epicsEventId event;
+    epicsEventId doneEvent;
+} flushWorker_t;
+
+/* Register shadow entry, one per (function, addr) */
+typedef struct {
+    bool valid;
+    functionsArgs_t value;
+    /* Time the value was last read from or written to hardware */
+    epicsTimeStamp updated;
+    /* Order of the HALCS call the value came from */
+    int ioSeq;
+} regShadow_t;
+
+/* Event counter state, one per trigger channel */
+typedef struct {
+    /* lastCnt and lastTime hold a counter sample */
+    bool valid;
+    /* total holds an accumulated count */
+    bool totalValid;
+    /* rate holds an average */
+    bool rateValid;
+    epicsUInt32 lastCnt;
+    epicsTimeStamp lastTime;
+    epicsUInt64 total;
+    epicsFloat64 rate;
+    /* Counter resets written to hardware, and the ones already accounted
+     * for in total */
+    epicsUInt32 resetGen;
+    epicsUInt32 resetSeen;
+} cntState_t;
+
+/* Parameters of a group of trigger channel event counters */
+typedef struct {
+    int function;
+    int totalFunction;
+    int rateFunction;
+    int windowFunction;
+    int numChannels;
+} cntFuncs_t;
 
 /* These are the drvInfo strings that are used to identify the parameters.
  * They are used by asyn clients, including standard asyn device support */
@@ -229,10 +555,97 @@ private:
 #define P_TimRxAfcHsDivString           "TIM_RX_AFC_HS_DIV"      /* asynUInt32Digital,  r/w */
 #define P_TimRxAfcSi57xFreqString       "TIM_RX_AFC_SI57XFREQ"      /* asynUInt32Digital,  r/w */
 
+#define P_TimRxStatusPollPeriodString   "TIM_RX_STATUS_POLL_PERIOD"      /* asynFloat64,  r/w */
+#define P_TimRxStatusPollTimeString     "TIM_RX_STATUS_POLL_TIME"      /* asynFloat64,  r/o */
+#define P_TimRxCntPollPeriodString      "TIM_RX_CNT_POLL_PERIOD"      /* asynFloat64,  r/w */
+#define P_TimRxCntPollTimeString        "TIM_RX_CNT_POLL_TIME"      /* asynFloat64,  r/o */
+#define P_TimRxCntPollSkippedString     "TIM_RX_CNT_POLL_SKIPPED"      /* asynUInt32Digital,  r/o */
+#define P_TimRxWriteHoldoffString       "TIM_RX_WRITE_HOLDOFF"      /* asynFloat64,  r/w */
+#define P_TimRxWriteCoalescedString     "TIM_RX_WRITE_COALESCED"      /* asynUInt32Digital,  r/o */
+#define P_TimRxWriteFlushLatencyString  "TIM_RX_WRITE_FLUSH_LATENCY"      /* asynFloat64,  r/o */
+#define P_TimRxWriteFlushLatencyMaxString "TIM_RX_WRITE_FLUSH_LATENCY_MAX"      /* asynFloat64,  r/o */
+#define P_TimRxWriteFlushLatencyAvgString "TIM_RX_WRITE_FLUSH_LATENCY_AVG"      /* asynFloat64,  r/o */
+#define P_TimRxSi57xPollPeriodString    "TIM_RX_SI57X_POLL_PERIOD"      /* asynFloat64,  r/w */
+#define P_TimRxRtmSi57xAgeString        "TIM_RX_RTM_SI57X_AGE"      /* asynFloat64,  r/o */
+#define P_TimRxAfcSi57xAgeString        "TIM_RX_AFC_SI57X_AGE"      /* asynFloat64,  r/o */
+#define P_TimRxRtmSi57xFreqErrString    "TIM_RX_RTM_SI57X_FREQ_ERR"      /* asynFloat64,  r/o */
+#define P_TimRxAfcSi57xFreqErrString    "TIM_RX_AFC_SI57X_FREQ_ERR"      /* asynFloat64,  r/o */
+#define P_TimRxShadowTtlString          "TIM_RX_SHADOW_TTL"      /* asynFloat64,  r/w */
+#define P_TimRxShadowHitsString         "TIM_RX_SHADOW_HITS"      /* asynUInt32Digital,  r/o */
+#define P_TimRxShadowMissesString       "TIM_RX_SHADOW_MISSES"      /* asynUInt32Digital,  r/o */
+#define P_TimRxWriteElideString         "TIM_RX_WRITE_ELIDE"      /* asynUInt32Digital,  r/w */
+#define P_TimRxWriteElidedString        "TIM_RX_WRITE_ELIDED"      /* asynUInt32Digital,  r/o */
+#define P_TimRxWriteElideAgeString      "TIM_RX_WRITE_ELIDE_AGE"      /* asynFloat64,  r/w */
+#define P_TimRxStartupTimeString        "TIM_RX_STARTUP_TIME"      /* asynFloat64,  r/o */
+#define P_TimRxBreakerThresholdString   "TIM_RX_BREAKER_THRESHOLD"      /* asynUInt32Digital,  r/w */
+#define P_TimRxBreakerStateString       "TIM_RX_BREAKER_STATE"      /* asynUInt32Digital,  r/o */
+#define P_TimRxBreakerTripsString       "TIM_RX_BREAKER_TRIPS"      /* asynUInt32Digital,  r/o */
+#define P_TimRxBreakerOpenTimeString    "TIM_RX_BREAKER_OPEN_TIME"      /* asynFloat64,  r/o */
+#define P_TimRxPortLaneWaitHistString   "TIM_RX_PORT_LANE_WAIT_HIST"      /* asynInt32Array,  r/o */
+#define P_TimRxPortLaneDepthHistString  "TIM_RX_PORT_LANE_DEPTH_HIST"      /* asynInt32Array,  r/o */
+#define P_TimRxPollLaneWaitHistString   "TIM_RX_POLL_LANE_WAIT_HIST"      /* asynInt32Array,  r/o */
+#define P_TimRxPollLaneDepthHistString  "TIM_RX_POLL_LANE_DEPTH_HIST"      /* asynInt32Array,  r/o */
+#define P_TimRxAmcRateString            "TIM_RX_AMC_RATE"      /* asynFloat64,  r/o */
+#define P_TimRxAmcRateWindowString      "TIM_RX_AMC_RATE_WINDOW"      /* asynFloat64,  r/w */
+#define P_TimRxFmc1RateString           "TIM_RX_FMC1_RATE"      /* asynFloat64,  r/o */
+#define P_TimRxFmc1RateWindowString     "TIM_RX_FMC1_RATE_WINDOW"      /* asynFloat64,  r/w */
+#define P_TimRxFmc2RateString           "TIM_RX_FMC2_RATE"      /* asynFloat64,  r/o */
+#define P_TimRxFmc2RateWindowString     "TIM_RX_FMC2_RATE_WINDOW"      /* asynFloat64,  r/w */
+#define P_TimRxAmcCntTotalString        "TIM_RX_AMC_CNT_TOTAL"      /* asynInt64,  r/o */
+#define P_TimRxFmc1CntTotalString       "TIM_RX_FMC1_CNT_TOTAL"      /* asynInt64,  r/o */
+#define P_TimRxFmc2CntTotalString       "TIM_RX_FMC2_CNT_TOTAL"      /* asynInt64,  r/o */
+#define P_TimRxFpgaClkString            "TIM_RX_FPGA_CLK"      /* asynFloat64,  r/w */
+#define P_TimRxAmcDelayString           "TIM_RX_AMC_DELAY"      /* asynFloat64,  r/w */
+#define P_TimRxAmcWidthString           "TIM_RX_AMC_WIDTH"      /* asynFloat64,  r/w */
+#define P_TimRxFmc1DelayString          "TIM_RX_FMC1_DELAY"      /* asynFloat64,  r/w */
+#define P_TimRxFmc1WidthString          "TIM_RX_FMC1_WIDTH"      /* asynFloat64,  r/w */
+#define P_TimRxFmc2DelayString          "TIM_RX_FMC2_DELAY"      /* asynFloat64,  r/w */
+#define P_TimRxFmc2WidthString          "TIM_RX_FMC2_WIDTH"      /* asynFloat64,  r/w */
+#define P_TimRxAmcEnMaskString          "TIM_RX_AMC_EN_MASK"      /* asynUInt32Digital,  r/w */
+#define P_TimRxAmcPolMaskString         "TIM_RX_AMC_POL_MASK"      /* asynUInt32Digital,  r/w */
+#define P_TimRxAmcLogMaskString         "TIM_RX_AMC_LOG_MASK"      /* asynUInt32Digital,  r/w */
+#define P_TimRxAmcItlMaskString         "TIM_RX_AMC_ITL_MASK"      /* asynUInt32Digital,  r/w */
+#define P_TimRxAmcDirMaskString         "TIM_RX_AMC_DIR_MASK"      /* asynUInt32Digital,  r/w */
+#define P_TimRxFmc1EnMaskString         "TIM_RX_FMC1_EN_MASK"      /* asynUInt32Digital,  r/w */
+#define P_TimRxFmc1PolMaskString        "TIM_RX_FMC1_POL_MASK"      /* asynUInt32Digital,  r/w */
+#define P_TimRxFmc1LogMaskString        "TIM_RX_FMC1_LOG_MASK"      /* asynUInt32Digital,  r/w */
+#define P_TimRxFmc1ItlMaskString        "TIM_RX_FMC1_ITL_MASK"      /* asynUInt32Digital,  r/w */
+#define P_TimRxFmc1DirMaskString        "TIM_RX_FMC1_DIR_MASK"      /* asynUInt32Digital,  r/w */
+#define P_TimRxFmc2EnMaskString         "TIM_RX_FMC2_EN_MASK"      /* asynUInt32Digital,  r/w */
+#define P_TimRxFmc2PolMaskString        "TIM_RX_FMC2_POL_MASK"      /* asynUInt32Digital,  r/w */
+#define P_TimRxFmc2LogMaskString        "TIM_RX_FMC2_LOG_MASK"      /* asynUInt32Digital,  r/w */
+#define P_TimRxFmc2ItlMaskString        "TIM_RX_FMC2_ITL_MASK"      /* asynUInt32Digital,  r/w */
+#define P_TimRxFmc2DirMaskString        "TIM_RX_FMC2_DIR_MASK"      /* asynUInt32Digital,  r/w */
+#define P_TimRxHwUnlockString           "TIM_RX_HW_UNLOCK"      /* asynUInt32Digital,  r/w */
+#define P_TimRxLockHoldMaxString        "TIM_RX_LOCK_HOLD_MAX"      /* asynFloat64,  r/o */
+#define P_TimRxLockHoldAvgString        "TIM_RX_LOCK_HOLD_AVG"      /* asynFloat64,  r/o */
+#define P_TimRxNumWorkersString         "TIM_RX_NUM_WORKERS"      /* asynUInt32Digital,  r/o */
+#define P_TimRxTraceDumpString          "TIM_RX_TRACE_DUMP"      /* asynUInt32Digital,  r/w */
+#define P_TimRxTraceBufString           "TIM_RX_TRACE_BUF"      /* asynInt32Array,  r/o */
+#define P_TimRxReadLatHistString        "TIM_RX_READ_LAT_HIST"      /* asynInt32Array,  r/o */
+#define P_TimRxReadLatP50String         "TIM_RX_READ_LAT_P50"      /* asynFloat64,  r/o */
+#define P_TimRxReadLatP99String         "TIM_RX_READ_LAT_P99"      /* asynFloat64,  r/o */
+#define P_TimRxReadLatMaxString         "TIM_RX_READ_LAT_MAX"      /* asynFloat64,  r/o */
+#define P_TimRxReadLatErrorsString      "TIM_RX_READ_LAT_ERRORS"      /* asynUInt32Digital,  r/o */
+#define P_TimRxReadLatTimeoutsString    "TIM_RX_READ_LAT_TIMEOUTS"      /* asynUInt32Digital,  r/o */
+#define P_TimRxWriteLatHistString       "TIM_RX_WRITE_LAT_HIST"      /* asynInt32Array,  r/o */
+#define P_TimRxWriteLatP50String        "TIM_RX_WRITE_LAT_P50"      /* asynFloat64,  r/o */
+#define P_TimRxWriteLatP99String        "TIM_RX_WRITE_LAT_P99"      /* asynFloat64,  r/o */
+#define P_TimRxWriteLatMaxString        "TIM_RX_WRITE_LAT_MAX"      /* asynFloat64,  r/o */
+#define P_TimRxWriteLatErrorsString     "TIM_RX_WRITE_LAT_ERRORS"      /* asynUInt32Digital,  r/o */
+#define P_TimRxWriteLatTimeoutsString   "TIM_RX_WRITE_LAT_TIMEOUTS"      /* asynUInt32Digital,  r/o */
+#define P_TimRxSi57xLatHistString       "TIM_RX_SI57X_LAT_HIST"      /* asynInt32Array,  r/o */
+#define P_TimRxSi57xLatP50String        "TIM_RX_SI57X_LAT_P50"      /* asynFloat64,  r/o */
+#define P_TimRxSi57xLatP99String        "TIM_RX_SI57X_LAT_P99"      /* asynFloat64,  r/o */
+#define P_TimRxSi57xLatMaxString        "TIM_RX_SI57X_LAT_MAX"      /* asynFloat64,  r/o */
+#define P_TimRxSi57xLatErrorsString     "TIM_RX_SI57X_LAT_ERRORS"      /* asynUInt32Digital,  r/o */
+#define P_TimRxSi57xLatTimeoutsString   "TIM_RX_SI57X_LAT_TIMEOUTS"      /* asynUInt32Digital,  r/o */
+#define P_TimRxLatResetString           "TIM_RX_LAT_RESET"      /* asynUInt32Digital,  r/w */
+
 class drvTimRx : public asynPortDriver {
     public:
         drvTimRx(const char *portName, const char *endpoint,
-                int timRxNumber, int verbose, int timeout);
+                int timRxNumber, int verbose, int timeout, int numWorkers);
         ~drvTimRx();
 
         /* These are the methods that we override from asynPortDriver */
@@ -246,39 +659,51 @@ class drvTimRx : public asynPortDriver {
         /* These methods are overwritten from asynPortDriver */
         virtual asynStatus connect(asynUser* pasynUser);
         virtual asynStatus disconnect(asynUser* pasynUser);
+        /* Overridden to account the driver lock hold times */
+        virtual asynStatus lock();
+        virtual asynStatus unlock();
+        virtual void report(FILE *fp, int details);
 
-        /* Overloaded functions for extracting service name*/
-        const char *doGetServiceNameFromFunc (functionsInt32_t &func) const
-        {
-            return func.serviceName;
-        }
+        /* Background poller. Must be public as it is called from the
+         * poll scheduler thread shared by all receivers */
+        epicsFloat64 pollTimeToNext(const epicsTimeStamp *now);
+        void pollRun(const epicsTimeStamp *now);
 
-        const char *doGetServiceNameFromFunc (functionsFloat64_t &func) const
-        {
-            return func.serviceName;
-        }
+        /* Write coalescing flush threads. Must be public as it is called
+         * from a C thread function */
+        void flushTask(flushWorker_t *worker);
 
-        const char *doGetServiceNameFromFunc (functionsInt32Chan_t &func) const
-        {
-            return func.serviceName;
-        }
+        /* Connection manager thread. Must be public as it is called
+         * from a C thread function */
+        void connTask(void);
+
+        /* Wait for the first connection attempt, at most wait seconds.
+         * Returns asynSuccess if the board was reached */
+        asynStatus waitFirstConnect(epicsFloat64 wait);
 
-        /* Overloaded function mappings called by functionsAny_t */
-        asynStatus doExecuteHwWriteFunction(functionsInt32_t &func, char *service,
-                int addr, functionsArgs_t &functionParam) const;
-        asynStatus doExecuteHwWriteFunction(functionsFloat64_t &func, char *service,
-                int addr, functionsArgs_t &functionParam) const;
-        asynStatus doExecuteHwWriteFunction(functionsInt32Chan_t &func, char *service,
-                int addr, functionsArgs_t &functionParam) const;
+        /* Set the register shadow TTL of one parameter, in seconds. A
+         * negative TTL reverts to the default */
+        asynStatus setShadowTtl(const char *drvInfo, epicsFloat64 ttl);
+
+        /* Print the last num entries of the hardware access trace */
+        void dumpTrace(int num) const;
+
+        /* Overloaded function mappings called by executeHw*Function */
+        asynStatus doExecuteHwWriteFunction(hwAccess_t *access, const functionsInt32_t &func,
+                char *service, int addr, functionsArgs_t &functionParam) const;
+        asynStatus doExecuteHwWriteFunction(hwAccess_t *access, const functionsFloat64_t &func,
+                char *service, int addr, functionsArgs_t &functionParam) const;
+        asynStatus doExecuteHwWriteFunction(hwAccess_t *access, const functionsInt32Chan_t &func,
+                char *service, int addr, functionsArgs_t &functionParam) const;
         asynStatus executeHwWriteFunction(int functionId, int addr,
                 functionsArgs_t &functionParam);
 
-        asynStatus doExecuteHwReadFunction(functionsInt32_t &func, char *service,
-                int addr, functionsArgs_t &functionParam) const;
-        asynStatus doExecuteHwReadFunction(functionsFloat64_t &func, char *service,
-                int addr, functionsArgs_t &functionParam) const;
-        asynStatus doExecuteHwReadFunction(functionsInt32Chan_t &func, char *service,
-                int addr, functionsArgs_t &functionParam) const;
+        asynStatus doExecuteHwReadFunction(hwAccess_t *access, const functionsInt32_t &func,
+                char *service, int addr, functionsArgs_t &functionParam) const;
+        asynStatus doExecuteHwReadFunction(hwAccess_t *access, const functionsFloat64_t &func,
+                char *service, int addr, functionsArgs_t &functionParam) const;
+        asynStatus doExecuteHwReadFunction(hwAccess_t *access, const functionsInt32Chan_t &func,
+                char *service, int addr, functionsArgs_t &functionParam) const;
         asynStatus executeHwReadFunction(int functionId, int addr,
                 functionsArgs_t &functionParam);
 
@@ -289,6 +714,9 @@ class drvTimRx : public asynPortDriver {
                 int *serviceIDArg) const;
         asynStatus getFullServiceName (int timRxNumber, int addr, const char *serviceName,
                 char *fullServiceName, int fullServiceNameSize) const;
+        char *getServiceName (int functionId) const;
+        const functionsHw_t *getHwFunc (int functionId) const;
+        unsigned getParamFlags (int functionId) const;
 
     protected:
         /** Values used for pasynUser->reason, and indexes into the parameter library. */
@@ -356,7 +784,93 @@ class drvTimRx : public asynPortDriver {
         int P_TimRxAfcN1;
         int P_TimRxAfcHsDiv;
         int P_TimRxAfcSi57xFreq;
-#define LAST_COMMAND P_TimRxAfcSi57xFreq
+        int P_TimRxStatusPollPeriod;
+        int P_TimRxStatusPollTime;
+        int P_TimRxCntPollPeriod;
+        int P_TimRxCntPollTime;
+        int P_TimRxCntPollSkipped;
+        int P_TimRxWriteHoldoff;
+        int P_TimRxWriteCoalesced;
+        int P_TimRxWriteFlushLatency;
+        int P_TimRxWriteFlushLatencyMax;
+        int P_TimRxWriteFlushLatencyAvg;
+        int P_TimRxSi57xPollPeriod;
+        int P_TimRxRtmSi57xAge;
+        int P_TimRxAfcSi57xAge;
+        int P_TimRxRtmSi57xFreqErr;
+        int P_TimRxAfcSi57xFreqErr;
+        int P_TimRxShadowTtl;
+        int P_TimRxShadowHits;
+        int P_TimRxShadowMisses;
+        int P_TimRxWriteElide;
+        int P_TimRxWriteElided;
+        int P_TimRxWriteElideAge;
+        int P_TimRxStartupTime;
+        int P_TimRxBreakerThreshold;
+        int P_TimRxBreakerState;
+        int P_TimRxBreakerTrips;
+        int P_TimRxBreakerOpenTime;
+        int P_TimRxPortLaneWaitHist;
+        int P_TimRxPortLaneDepthHist;
+        int P_TimRxPollLaneWaitHist;
+        int P_TimRxPollLaneDepthHist;
+        int P_TimRxAmcRate;
+        int P_TimRxAmcRateWindow;
+        int P_TimRxFmc1Rate;
+        int P_TimRxFmc1RateWindow;
+        int P_TimRxFmc2Rate;
+        int P_TimRxFmc2RateWindow;
+        int P_TimRxAmcCntTotal;
+        int P_TimRxFmc1CntTotal;
+        int P_TimRxFmc2CntTotal;
+        int P_TimRxFpgaClk;
+        int P_TimRxAmcDelay;
+        int P_TimRxAmcWidth;
+        int P_TimRxFmc1Delay;
+        int P_TimRxFmc1Width;
+        int P_TimRxFmc2Delay;
+        int P_TimRxFmc2Width;
+        int P_TimRxAmcEnMask;
+        int P_TimRxAmcPolMask;
+        int P_TimRxAmcLogMask;
+        int P_TimRxAmcItlMask;
+        int P_TimRxAmcDirMask;
+        int P_TimRxFmc1EnMask;
+        int P_TimRxFmc1PolMask;
+        int P_TimRxFmc1LogMask;
+        int P_TimRxFmc1ItlMask;
+        int P_TimRxFmc1DirMask;
+        int P_TimRxFmc2EnMask;
+        int P_TimRxFmc2PolMask;
+        int P_TimRxFmc2LogMask;
+        int P_TimRxFmc2ItlMask;
+        int P_TimRxFmc2DirMask;
+        int P_TimRxHwUnlock;
+        int P_TimRxLockHoldMax;
+        int P_TimRxLockHoldAvg;
+        int P_TimRxNumWorkers;
+        int P_TimRxTraceDump;
+        int P_TimRxTraceBuf;
+        int P_TimRxReadLatHist;
+        int P_TimRxReadLatP50;
+        int P_TimRxReadLatP99;
+        int P_TimRxReadLatMax;
+        int P_TimRxReadLatErrors;
+        int P_TimRxReadLatTimeouts;
+        int P_TimRxWriteLatHist;
+        int P_TimRxWriteLatP50;
+        int P_TimRxWriteLatP99;
+        int P_TimRxWriteLatMax;
+        int P_TimRxWriteLatErrors;
+        int P_TimRxWriteLatTimeouts;
+        int P_TimRxSi57xLatHist;
+        int P_TimRxSi57xLatP50;
+        int P_TimRxSi57xLatP99;
+        int P_TimRxSi57xLatMax;
+        int P_TimRxSi57xLatErrors;
+        int P_TimRxSi57xLatTimeouts;
+        int P_TimRxLatReset;
+#define LAST_COMMAND P_TimRxLatReset
 
     private:
         /* Our data */
@@ -365,14 +879,186 @@ class drvTimRx : public asynPortDriver {
         int timRxNumber;
         int verbose;
         int timeout;
+        int numWorkers;
         char *timRxPortName;
-        std::unordered_map<int, functionsAny_t> timRxHwFunc;
+        /* Parameter registry, in parameter creation order */
+        static const paramDesc_t timRxParams[];
+        static const size_t timRxNumParams;
+        /* Full service names, resolved once at construction and indexed
+         * by functionId - FIRST_COMMAND. Entries point into timRxServicePool */
+        std::vector<char *> timRxServiceNames;
+        std::vector<char *> timRxServicePool;
+        /* Poller schedule. Protected by the driver lock */
+        bool pollRestart;
+        epicsTimeStamp pollNextStatus;
+        epicsTimeStamp pollNextCnt;
+        epicsTimeStamp pollNextSi57x;
+        epicsUInt32 pollCntSkipped;
+        bool pollRegistered;
+        /* HALCS client, shared with the other receiver of the same board */
+        timRxSharedClient_t *timRxSharedClient;
+        /* Connection manager. The client is connected while
+         * timRxSharedClient is set */
+        epicsEventId connEvent;
+        epicsEventId connDoneEvent;
+        /* Signaled once the first connection attempt is done */
+        epicsEventId connFirstEvent;
+        epicsTimeStamp createTime;
+        bool connTaskExit;
+        bool hwSnapshotDone;
+        /* Circuit breaker. Protected by the driver lock */
+        int breakerState;
+        epicsUInt32 breakerFailures;
+        epicsUInt32 breakerTrips;
+        epicsTimeStamp breakerOpenSince;
+        epicsFloat64 breakerOpenTotal;
+        /* Event counters, indexed in counter sweep order. Protected by the
+         * driver lock */
+        cntState_t cntState[MAX_TRIGGER_CH];
+        /* HALCS calls on one register are issued in ticket order, see
+         * waitRegTurn. The stripe lock protects the done tickets of its
+         * registers and their waiters. It is only held briefly, never
+         * for a HALCS call nor while taking the driver lock */
+        epicsMutexId regLocks[TIM_RX_REG_LOCK_STRIPES];
+        std::vector<regTurnWaiter_t *> regTurnWaiters[TIM_RX_REG_LOCK_STRIPES];
+        /* Depth of lockClient holds by the thread owning the driver lock.
+         * HALCS calls made inside keep the driver lock */
+        int clientHoldDepth;
+        /* The last HALCS call, for storeRegShadow. Protected by the
+         * driver lock */
+        int hwIoSlot;
+        int hwIoSeq;
+        /* Driver lock hold times. Protected by the driver lock */
+        int lockDepth;
+        epicsTimeStamp lockTaken;
+        epicsFloat64 lockHoldMax;
+        epicsFloat64 lockHoldSum;
+        epicsUInt32 lockHolds;
+        /* Execution lane histograms. Protected by the driver lock */
+        laneStats_t laneStats[numLanes];
+        /* Hardware access trace ring, written with no lock. Writers claim
+         * an entry by incrementing traceHead atomically and publish it
+         * through its seq */
+        std::vector<traceEntry_t> traceRing;
+        size_t traceHead;
+        /* HALCS call latencies, indexed by
+         * (functionId - FIRST_COMMAND)*latNumOps + op. Updated with no
+         * lock, see latRecord */
+        std::vector<latStats_t> latStats;
+        latParams_t latParams[latNumOps];
+        /* Write coalescing stage. pendingWrites is indexed by
+         * (functionId - FIRST_COMMAND)*MAX_ADDR + addr and each worker
+         * list holds the indexes in use assigned to it. Protected by the
+         * driver lock */
+        std::vector<pendingWrite_t> pendingWrites;
+        epicsUInt32 writeCoalesced;
+        epicsFloat64 flushLatencyMax;
+        epicsFloat64 flushLatencySum;
+        epicsUInt32 flushLatencies;
+        std::vector<flushWorker_t> flushWorkers;
+        bool flushTaskExit;
+        /* Sweep reads handed to the workers. pollReadClient is set with
+         * the driver lock held, the counts are updated atomically and the
+         * sweep waits on pollReadDoneEvent for the last read */
+        timRxSharedClient_t *pollReadClient;
+        int pollReadsLeft;
+        int pollReadTimeouts;
+        epicsUInt32 pollReadThreshold;
+        epicsEventId pollReadDoneEvent;
+        /* Si57x register shadows. Protected by the driver lock */
+        si57xParams_t si57xParams[si57xNumOsc];
+        /* Trigger channel times */
+        trigTimeParams_t trigTimeParams[trigTimeNum];
+        /* Packed trigger attributes */
+        std::vector<packedParams_t> packedParams;
+        si57xShadow_t si57xShadow[si57xNumOsc];
+        Si57xSolver si57xSolver;
+        /* Register shadow. regShadow is indexed like pendingWrites and
+         * regShadowTtl by functionId - FIRST_COMMAND, with negative entries
+         * taking the default TTL. Protected by the driver lock */
+        std::vector<regShadow_t> regShadow;
+        /* Tickets of the HALCS calls issued on each (function, addr),
+         * incremented atomically with the driver lock held, and the
+         * ticket of the last one done. Tickets also order the shadow */
+        std::vector<int> regIoSeq;
+        std::vector<int> regIoDone;
+        std::vector<epicsFloat64> regShadowTtl;
+        epicsUInt32 regShadowHits;
+        epicsUInt32 regShadowMisses;
+        epicsUInt32 writeElided;
 
         /* Our private methods */
 
+        /* Parameter registry handling */
+        asynStatus createParams();
+        void setInitialParams();
+        asynStatus snapshotHw();
+
+        /* Service name table management */
+        char *internServiceName(const char *serviceName);
+        asynStatus buildServiceNameTable();
+        void destroyServiceNameTable();
+
+        /* Status poller management */
+        asynStatus startPollTask();
+        void stopPollTask();
+        asynStatus pollStatus();
+        asynStatus pollCounters();
+        asynStatus pollLaneBegin(timRxSharedClient_t **sharedClient);
+        void pollLaneEnd(timRxSharedClient_t *sharedClient);
+        asynStatus pollReadHw(timRxSharedClient_t *sharedClient, int worker,
+                int functionId, int addr, epicsUInt32 *value, epicsFloat64 *wait,
+                int *depth, halcs_client_err_e *err);
+        void pollReadOne(timRxSharedClient_t *sharedClient, int worker,
+                pollRead_t *read);
+        void pollReadBatch(timRxSharedClient_t *sharedClient,
+                asynStatus laneStatus, pollRead_t *reads, size_t num);
+        void runPollReads(flushWorker_t *worker);
+        void laneRecord(int lane, epicsFloat64 wait, int depth);
+        void updateCounter(const cntFuncs_t &funcs, int addr, cntState_t *state,
+                epicsUInt32 cnt, const epicsTimeStamp *time);
+        cntState_t *getCntState(int rstFunction, int addr);
+        void publishLaneStats();
+
+        /* Hardware access trace */
+        void traceRecord(int functionId, int addr, int write, int lane,
+                const functionsArgs_t &value, const epicsTimeStamp *start,
+                const epicsTimeStamp *end, int err);
+        bool traceGet(size_t n, traceEntry_t *entry) const;
+        void traceSnapshot(size_t num, std::vector<traceEntry_t> &entries) const;
+        void publishTrace(epicsUInt32 num);
+
+        /* HALCS call latency statistics */
+        void initLatParams();
+        void latRecord(int functionId, int op, epicsFloat64 time, int err);
+        void latSum(int op, int functionId, latStats_t *sum) const;
+        epicsFloat64 latPercentile(const latStats_t &stats, epicsFloat64 fraction) const;
+        void resetLatStats();
+        void publishLatStats();
+
+        /* Write coalescing stage management */
+        asynStatus startFlushTask();
+        void stopFlushTask();
+        bool queueWrite(int functionId, epicsUInt32 mask, int addr);
+        void resetFlushStats();
+        epicsFloat64 flushWrites(flushWorker_t *worker, const epicsTimeStamp *now,
+                epicsFloat64 holdoff, bool force);
+        void signalFlushWorkers();
+
         /* Client connection management */
-        asynStatus timRxClientConnect(asynUser* pasynUser);
+        asynStatus timRxClientConnect(asynUser* pasynUser,
+                timRxSharedClient_t *sharedClient);
         asynStatus timRxClientDisconnect(asynUser* pasynUser);
+        asynStatus lockClient();
+        void unlockClient();
+        asynStatus probeClient(timRxSharedClient_t *sharedClient) const;
+        epicsUInt32 getBreakerThreshold();
+        void hwAccessDone(asynStatus status, halcs_client_err_e err);
+        void setBreakerState(int state);
+        asynStatus getBreakerOpenTime(epicsFloat64 *value);
+        asynStatus startConnTask();
+        void stopConnTask();
+        asynStatus reapplyConfig();
 
         /* General set/get hardware functions */
         asynStatus setParamGeneric(int funcionId, int addr);
@@ -386,52 +1072,52 @@ class drvTimRx : public asynPortDriver {
          * fit into the general set/get template */
         asynStatus setRtmSi57xFreq(epicsUInt32 value, int addr);
         asynStatus setAfcSi57xFreq(epicsUInt32 value, int addr);
-        asynStatus setSi57xFreq(epicsUInt32 value, uint32_t *n1, uint32_t *hs_div,
-                uint32_t *ReqLo, uint32_t *ReqHi);
+        asynStatus setSi57xFreq(epicsUInt32 value, si57xRegs_t *regs);
         asynStatus getRtmSi57xFreq(epicsUInt32 *value, int addr);
         asynStatus getAfcSi57xFreq(epicsUInt32 *value, int addr);
         asynStatus getSi57xFreq(epicsUInt32 *value, uint32_t n1, uint32_t hs_div,
                 uint32_t ReqLo, uint32_t ReqHi);
 
+        /* Si57x register shadow management */
+        void initSi57xShadow();
+        void initTrigTimeParams();
+        int getTrigTime(int functionId) const;
+        int getTrigTimeRaw(int functionId) const;
+        asynStatus setTrigTime(int trigTime, int addr);
+        void publishTrigTime(int trigTime, int addr);
+        void publishTrigTimes();
+        void initPackedParams();
+        int getPacked(int functionId) const;
+        int getPackedChan(int functionId) const;
+        asynStatus setPacked(int packed, epicsUInt32 mask);
+        asynStatus getPackedHw(int packed, epicsUInt32 *value, epicsUInt32 mask);
+        asynStatus mergeHwBits(int functionId, int addr, epicsUInt32 mask,
+                functionsArgs_t &functionArgs);
+        asynStatus beginHwAccess(int functionId, int addr, hwAccess_t *access);
+        void endHwAccess(hwAccess_t *access);
+        bool regTurnReady(int slot, int ticket) const;
+        void waitRegTurn(int slot, int ticket);
+        void regTurnDone(hwAccess_t *access);
+        void resetLockStats();
+        void publishLockStats();
+        void publishPacked(int packed);
+        void publishPackedAll();
+        int getSi57xOsc(int functionId) const;
+        void updateSi57xShadow(int osc, epicsUInt32 n1, epicsUInt32 hsDiv,
+                epicsUInt32 rfreqLo, epicsUInt32 rfreqHi);
+        asynStatus refreshSi57xShadow(int osc);
+        asynStatus getSi57xShadowFreq(int osc, epicsUInt32 *value);
+        asynStatus getSi57xShadowAge(int osc, epicsFloat64 *value);
+
+        /* Register shadow management */
+        void initRegShadow();
+        void invalidateRegShadow();
+        bool readRegShadow(int functionId, int addr, functionsArgs_t &functionArgs);
+        void storeRegShadow(int functionId, int addr,
+                const functionsArgs_t &functionArgs);
+        bool elideWrite(int functionId, int addr, const functionsArgs_t &functionArgs,
+                asynParamType type);
+
 };
 
 #define NUM_PARAMS (&LAST_COMMAND - &FIRST_COMMAND + 1)
-
-/********************************************************************/
-/*************** fucntionsAny_t template functions ******************/
-/********************************************************************/
-
-/* Read function for Hw execution */
-template<typename T>
-asynStatus functionsAny_t::executeHwReadFunction(const drvTimRx& drvTimRx,
-        const any& functionFp, char *service,
-    int addr, functionsArgs_t &functionParam)
-{
-    if(!any_cast<T>(functionFp).read) {
-        return asynSuccess;
-    }
-    auto functionFpCast = any_cast<T>(functionFp);
-    return drvTimRx.doExecuteHwReadFunction(functionFpCast, service, addr, functionParam);
-}
-
-/* Write function for Hw execution */
-template<typename T>
-asynStatus functionsAny_t::executeHwWriteFunction(const drvTimRx& drvTimRx,
-        const any& functionFp, char *service,
-    int addr, functionsArgs_t &functionParam)
-{
-    if(!any_cast<T>(functionFp).write) {
-        return asynSuccess;
-    }
-    auto functionFpCast = any_cast<T>(functionFp);
-    return drvTimRx.doExecuteHwWriteFunction(functionFpCast, service, addr, functionParam);
-}
-
-/* Service name utilities */
-template<typename T>
-const char *functionsAny_t::getServiceNameFromFunc(const drvTimRx& drvTimRx,
-        const any& functionFp) const
-{
-    auto functionFpCast = any_cast<T>(functionFp);
-    return drvTimRx.doGetServiceNameFromFunc(functionFpCast);
-}
@@ -0,0 +1,40 @@
+# Records of one receiver served by a multi-receiver IOC. Sourced by
+# stTimRxCrate.cmd once per receiver, with N, P and R set
+
+epicsEnvSet("PORT", "$(TIM_RX_NAME)$(N)")
+
+# Write elision, which skips writes of values the hardware already holds,
+# is off by default. Enable it with WRITE_ELIDE=1 in the macros of
+# TimRxCfg.template below, or at run time through WriteElide-Sel. Once
+# saved, the autosave value takes precedence over the macro
+
+dbLoadRecords("${TOP}/TimRxApp/Db/TimRxCfg.template", "P=${P}, R=${R}, PORT=$(PORT), ADDR=0, TIMEOUT=1")
+
+dbLoadRecords("${TOP}/TimRxApp/Db/TimRxFMCTrigCh.template", "P=${P}, R=${R}, S=FMC1, C=0, PORT=$(PORT), ADDR=0, TIMEOUT=1")
+dbLoadRecords("${TOP}/TimRxApp/Db/TimRxFMCTrigCh.template", "P=${P}, R=${R}, S=FMC1, C=1, PORT=$(PORT), ADDR=1, TIMEOUT=1")
+dbLoadRecords("${TOP}/TimRxApp/Db/TimRxFMCTrigCh.template", "P=${P}, R=${R}, S=FMC1, C=2, PORT=$(PORT), ADDR=2, TIMEOUT=1")
+dbLoadRecords("${TOP}/TimRxApp/Db/TimRxFMCTrigCh.template", "P=${P}, R=${R}, S=FMC1, C=3, PORT=$(PORT), ADDR=3, TIMEOUT=1")
+dbLoadRecords("${TOP}/TimRxApp/Db/TimRxFMCTrigCh.template", "P=${P}, R=${R}, S=FMC1, C=4, PORT=$(PORT), ADDR=4, TIMEOUT=1")
+
+dbLoadRecords("${TOP}/TimRxApp/Db/TimRxFMCTrigCh.template", "P=${P}, R=${R}, S=FMC2, C=0, PORT=$(PORT), ADDR=0, TIMEOUT=1")
+dbLoadRecords("${TOP}/TimRxApp/Db/TimRxFMCTrigCh.template", "P=${P}, R=${R}, S=FMC2, C=1, PORT=$(PORT), ADDR=1, TIMEOUT=1")
+dbLoadRecords("${TOP}/TimRxApp/Db/TimRxFMCTrigCh.template", "P=${P}, R=${R}, S=FMC2, C=2, PORT=$(PORT), ADDR=2, TIMEOUT=1")
+dbLoadRecords("${TOP}/TimRxApp/Db/TimRxFMCTrigCh.template", "P=${P}, R=${R}, S=FMC2, C=3, PORT=$(PORT), ADDR=3, TIMEOUT=1")
+dbLoadRecords("${TOP}/TimRxApp/Db/TimRxFMCTrigCh.template", "P=${P}, R=${R}, S=FMC2, C=4, PORT=$(PORT), ADDR=4, TIMEOUT=1")
+
+dbLoadRecords("${TOP}/TimRxApp/Db/TimRxAMCTrigCh.template", "P=${P}, R=${R}, S=AMC, C=0, PORT=$(PORT), ADDR=0, TIMEOUT=1")
+dbLoadRecords("${TOP}/TimRxApp/Db/TimRxAMCTrigCh.template", "P=${P}, R=${R}, S=AMC, C=1, PORT=$(PORT), ADDR=1, TIMEOUT=1")
+dbLoadRecords("${TOP}/TimRxApp/Db/TimRxAMCTrigCh.template", "P=${P}, R=${R}, S=AMC, C=2, PORT=$(PORT), ADDR=2, TIMEOUT=1")
+dbLoadRecords("${TOP}/TimRxApp/Db/TimRxAMCTrigCh.template", "P=${P}, R=${R}, S=AMC, C=3, PORT=$(PORT), ADDR=3, TIMEOUT=1")
+dbLoadRecords("${TOP}/TimRxApp/Db/TimRxAMCTrigCh.template", "P=${P}, R=${R}, S=AMC, C=4, PORT=$(PORT), ADDR=4, TIMEOUT=1")
+dbLoadRecords("${TOP}/TimRxApp/Db/TimRxAMCTrigCh.template", "P=${P}, R=${R}, S=AMC, C=5, PORT=$(PORT), ADDR=5, TIMEOUT=1")
+dbLoadRecords("${TOP}/TimRxApp/Db/TimRxAMCTrigCh.template", "P=${P}, R=${R}, S=AMC, C=6, PORT=$(PORT), ADDR=6, TIMEOUT=1")
+dbLoadRecords("${TOP}/TimRxApp/Db/TimRxAMCTrigCh.template", "P=${P}, R=${R}, S=AMC, C=7, PORT=$(PORT), ADDR=7, TIMEOUT=1")
+
+dbLoadRecords("${TOP}/TimRxApp/Db/TimRxTrigMask.template", "P=${P}, R=${R}, S=FMC1, NCH=5, MASK=0x1F, PORT=$(PORT), ADDR=0, TIMEOUT=1")
+dbLoadRecords("${TOP}/TimRxApp/Db/TimRxTrigMask.template", "P=${P}, R=${R}, S=FMC2, NCH=5, MASK=0x1F, PORT=$(PORT), ADDR=0, TIMEOUT=1")
+dbLoadRecords("${TOP}/TimRxApp/Db/TimRxTrigMask.template", "P=${P}, R=${R}, S=AMC, NCH=8, MASK=0xFF, PORT=$(PORT), ADDR=0, TIMEOUT=1")
+
+dbLoadRecords("$(ASYN)/db/asynRecord.db","P=${P}, R=${R}asyn,PORT=$(PORT),ADDR=0,OMAX=80,IMAX=80")
+
+asynSetTraceIOMask("$(PORT)",0,0x2)
@@ -0,0 +1,66 @@
+#!/bin/sh
+
+: ${EPICS_HOST_ARCH:?"Environment variable needs to be set"}
+: ${EPICS_PV_CRATE_PREFIX:?"Environment variable needs to be set"}
+
+VALID_TIM_RX_CRATE_LIST_STR="Use a list of receivers between 1 and 24, e.g. \"1-4,7,9-24\"."
+
+# Select endpoint.
+TIM_RX_ENDPOINT=$1
+
+if [ -z "$TIM_RX_ENDPOINT" ]; then
+    echo "\"TIM_RX_ENDPOINT\" variable unset."
+    exit 1
+fi
+
+# Select receivers served by this IOC.
+TIM_RX_CRATE_LIST=$2
+
+if [ -z "$TIM_RX_CRATE_LIST" ]; then
+    echo "\"TIM_RX_CRATE_LIST\" variable unset. "$VALID_TIM_RX_CRATE_LIST_STR
+    exit 1
+fi
+
+# Files generated for this receiver list. They live in the autosave
+# directory, which is in the request file path
+TIM_RX_CRATE_RECEIVERS_CMD=autosave/TimRxCrateReceivers.cmd
+TIM_RX_CRATE_REQ=auto_settings_crate.req
+
+: > ${TIM_RX_CRATE_RECEIVERS_CMD}
+: > autosave/${TIM_RX_CRATE_REQ}
+
+for TIM_RX_RANGE in $(echo ${TIM_RX_CRATE_LIST} | tr ',' ' '); do
+    TIM_RX_FIRST=${TIM_RX_RANGE%-*}
+    TIM_RX_LAST=${TIM_RX_RANGE#*-}
+
+    case "${TIM_RX_FIRST}${TIM_RX_LAST}" in
+        ""|*[!0-9]*)
+            echo "Unsupported TimRx list. "$VALID_TIM_RX_CRATE_LIST_STR
+            exit 1
+            ;;
+    esac
+
+    if [ "$TIM_RX_FIRST" -lt 1 ] || [ "$TIM_RX_LAST" -gt 24 ] || \
+        [ "$TIM_RX_FIRST" -gt "$TIM_RX_LAST" ]; then
+        echo "Unsupported TimRx list. "$VALID_TIM_RX_CRATE_LIST_STR
+        exit 1
+    fi
+
+    for TIM_RX_NUMBER in $(seq ${TIM_RX_FIRST} ${TIM_RX_LAST}); do
+        eval P=\${${EPICS_PV_CRATE_PREFIX}_TIM_RX_${TIM_RX_NUMBER}_PV_AREA_PREFIX}
+        eval R=\${${EPICS_PV_CRATE_PREFIX}_TIM_RX_${TIM_RX_NUMBER}_PV_DEVICE_PREFIX}
+
+        cat >> ${TIM_RX_CRATE_RECEIVERS_CMD} <<EOC
+epicsEnvSet("N", "${TIM_RX_NUMBER}")
+epicsEnvSet("P", "${P}")
+epicsEnvSet("R", "${R}")
+< TimRxReceiver.cmd
+
+EOC
+        echo "file \"TimRx_settings.req\", P=${P}, R=${R}" >> autosave/${TIM_RX_CRATE_REQ}
+    done
+done
+
+TIM_RX_ENDPOINT=${TIM_RX_ENDPOINT} TIM_RX_CRATE_LIST=${TIM_RX_CRATE_LIST} \
+    TIM_RX_CRATE_RECEIVERS_CMD=${TIM_RX_CRATE_RECEIVERS_CMD} TIM_RX_CRATE_REQ=${TIM_RX_CRATE_REQ} \
+    ../../bin/${EPICS_HOST_ARCH}/TimRx stTimRxCrate.cmd
@@ -9,7 +9,20 @@ epicsEnvSet("TOP","../..")
 dbLoadDatabase("${TOP}/dbd/TimRx.dbd")
 TimRx_registerRecordDeviceDriver (pdbbase)
 
-drvTimRxConfigure("$(TIM_RX_NAME)", "$(TIM_RX_ENDPOINT)", "$(TIM_RX_NUMBER)", "$(TIM_RX_VERBOSE)", "$(TIM_RX_TIMEOUT)")
+drvTimRxConfigure("$(TIM_RX_NAME)", "$(TIM_RX_ENDPOINT)", "$(TIM_RX_NUMBER)", "$(TIM_RX_VERBOSE)", "$(TIM_RX_TIMEOUT)", "$(TIM_RX_WORKERS)")
+
+# Serve reads of a parameter from the register shadow for up to ttl seconds
+# after the last hardware access. ShadowTtl-SP sets the default for the rest
+#drvTimRxSetShadowTtl("$(TIM_RX_NAME)", "TIM_RX_AMC_EVT", 2.0)
+
+# Every hardware access is recorded in a trace ring. Print the last
+# entries from the IOC shell with
+#drvTimRxTraceDump("$(TIM_RX_NAME)", 100)
+
+# Write elision, which skips writes of values the hardware already holds,
+# is off by default. Enable it with WRITE_ELIDE=1 in the macros of
+# TimRxCfg.template below, or at run time through WriteElide-Sel. Once
+# saved, the autosave value takes precedence over the macro
 
 ## Load record instances
 dbLoadRecords("${TOP}/TimRxApp/Db/TimRxCfg.template", "P=${P}, R=${R}, PORT=$(PORT), ADDR=0, TIMEOUT=1")
@@ -35,6 +48,10 @@ dbLoadRecords("${TOP}/TimRxApp/Db/TimRxAMCTrigCh.template", "P=${P}, R=${R}, S=A
 dbLoadRecords("${TOP}/TimRxApp/Db/TimRxAMCTrigCh.template", "P=${P}, R=${R}, S=AMC, C=6, PORT=$(PORT), ADDR=6, TIMEOUT=1")
 dbLoadRecords("${TOP}/TimRxApp/Db/TimRxAMCTrigCh.template", "P=${P}, R=${R}, S=AMC, C=7, PORT=$(PORT), ADDR=7, TIMEOUT=1")
 
+dbLoadRecords("${TOP}/TimRxApp/Db/TimRxTrigMask.template", "P=${P}, R=${R}, S=FMC1, NCH=5, MASK=0x1F, PORT=$(PORT), ADDR=0, TIMEOUT=1")
+dbLoadRecords("${TOP}/TimRxApp/Db/TimRxTrigMask.template", "P=${P}, R=${R}, S=FMC2, NCH=5, MASK=0x1F, PORT=$(PORT), ADDR=0, TIMEOUT=1")
+dbLoadRecords("${TOP}/TimRxApp/Db/TimRxTrigMask.template", "P=${P}, R=${R}, S=AMC, NCH=8, MASK=0xFF, PORT=$(PORT), ADDR=0, TIMEOUT=1")
+
 dbLoadRecords("$(ASYN)/db/asynRecord.db","P=${P}, R=${R}asyn,PORT=$(PORT),ADDR=0,OMAX=80,IMAX=80")
 
 < save_restore.cmd
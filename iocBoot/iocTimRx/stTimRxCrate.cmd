@@ -0,0 +1,53 @@
+< envPaths
+
+# Override default TOP variable
+epicsEnvSet("TOP","../..")
+
+< TimRx.config
+
+## Register all support components
+dbLoadDatabase("${TOP}/dbd/TimRx.dbd")
+TimRx_registerRecordDeviceDriver (pdbbase)
+
+# One port per receiver, named $(TIM_RX_NAME)<receiver number>
+drvTimRxConfigureCrate("$(TIM_RX_NAME)", "$(TIM_RX_ENDPOINT)", "$(TIM_RX_CRATE_LIST)", "$(TIM_RX_VERBOSE)", "$(TIM_RX_TIMEOUT)", "$(TIM_RX_WORKERS)")
+
+## Load record instances of every receiver. Generated by runTimRxCrate.sh
+< $(TIM_RX_CRATE_RECEIVERS_CMD)
+
+### save_restore setup. All receivers share a single save set, whose request
+### file is generated by runTimRxCrate.sh
+save_restoreSet_status_prefix("TimRx:")
+save_restoreSet_Debug(0)
+save_restoreSet_IncompleteSetsOk(1)
+save_restoreSet_DatedBackupFiles(1)
+save_restoreSet_NumSeqFiles(3)
+save_restoreSet_SeqPeriodInSeconds(300)
+
+set_savefile_path("$(TOP)/iocBoot/$(IOC)", "autosave")
+
+set_pass0_restoreFile("auto_settings_$(EPICS_PV_CRATE_PREFIX).sav")
+set_pass1_restoreFile("auto_settings_$(EPICS_PV_CRATE_PREFIX).sav")
+
+set_requestfile_path("$(TOP)/iocBoot/$(IOC)", "")
+set_requestfile_path("$(TOP)/iocBoot/$(IOC)", "autosave")
+set_requestfile_path("$(TOP)", "TimRxApp/Db")
+set_requestfile_path("$(AUTOSAVE)", "asApp/Db")
+
+dbLoadRecords("$(AUTOSAVE)/asApp/Db/save_restoreStatus.db", "P=$(EPICS_PV_CRATE_PREFIX):TimRx:")
+
+# Disable locking virtual memory as it can increase memory usage
+# unnecessarily in systems that run the IOC with SCHED_FIFO and
+# supports running threads with different priorities. See:
+# https://epics.anl.gov/base/R3-15/6-docs/RELEASE_NOTES.html and
+# https://github.com/epics-base/epics-base/commit/e721be4ff528bc1fff35b9e0cffd2a194f3e3675
+var dbThreadRealtimeLock 0
+
+iocInit()
+
+< initTimRxCommands
+
+# save things every thirty seconds
+create_monitor_set("$(TIM_RX_CRATE_REQ)", 60, "")
+create_triggered_set("$(TIM_RX_CRATE_REQ)", "$(EPICS_PV_CRATE_PREFIX):TimRx:Save-Cmd", "")
+set_savefile_name("$(TIM_RX_CRATE_REQ)", "auto_settings_$(EPICS_PV_CRATE_PREFIX).sav")